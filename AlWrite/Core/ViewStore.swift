@@ -7,6 +7,7 @@ final class ViewStore<ViewState, ViewEvent>: ObservableObject {
     private let eventHandler: (ViewEvent) -> Void
     private var viewCancellable: AnyCancellable?
     private let childCache = ViewStoreCache()
+    private var scopes: [AnyKeyPath: AnyObject] = [:]
 
     @Published
     public private(set) var state: ViewState
@@ -78,6 +79,15 @@ final class ViewStore<ViewState, ViewEvent>: ObservableObject {
     subscript<Value>(dynamicMember keyPath: KeyPath<ViewState, Value>) -> Value {
         state[keyPath: keyPath]
     }
+
+    func scope<Value: Equatable>(_ keyPath: KeyPath<ViewState, Value>) -> ViewStoreScope<Value> {
+        if let cached = scopes[keyPath] as? ViewStoreScope<Value> {
+            return cached
+        }
+        let scope = ViewStoreScope(statePublisher: $state, initialState: state, keyPath: keyPath)
+        scopes[keyPath] = scope
+        return scope
+    }
 }
 
 extension ViewStore: Equatable {
@@ -0,0 +1,40 @@
+import Combine
+import Foundation
+
+/// A slice of a view store's state that publishes only when the slice itself changes.
+///
+/// Scopes are memoized by key path in their `ViewStore`, so the slice is read and compared once per state
+/// change however many subscribers it has. `evaluationCount` and `emissionCount` count those reads and the
+/// changes that got through, which shows how much work a given event causes; `ViewStoreBenchmark` reports them.
+final class ViewStoreScope<Value: Equatable>: ObservableObject {
+    @Published
+    public private(set) var value: Value
+
+    private(set) var evaluationCount = 0
+    private(set) var emissionCount = 0
+    private var cancellable: AnyCancellable?
+
+    init<ViewState>(
+        statePublisher: Published<ViewState>.Publisher,
+        initialState: ViewState,
+        keyPath: KeyPath<ViewState, Value>
+    ) {
+        value = initialState[keyPath: keyPath]
+        cancellable = statePublisher
+            .dropFirst()
+            .sink { [weak self] state in
+                self?.receive(state[keyPath: keyPath])
+            }
+    }
+
+    var publisher: AnyPublisher<Value, Never> {
+        $value.eraseToAnyPublisher()
+    }
+
+    private func receive(_ newValue: Value) {
+        evaluationCount += 1
+        guard newValue != value else { return }
+        emissionCount += 1
+        value = newValue
+    }
+}
@@ -4,5 +4,10 @@ import Foundation
 import UIKit
 
 class DisplayModel {
-    var renderView: RenderView = RenderView(frame: CGRect.zero)
+    var renderView: RenderView = RenderView(frame: CGRect.zero, layerType: .model)
+    var captureRenderView: RenderView = RenderView(frame: CGRect.zero, layerType: .capture)
+
+    var renderViews: [RenderView] {
+        return [self.renderView, self.captureRenderView]
+    }
 }
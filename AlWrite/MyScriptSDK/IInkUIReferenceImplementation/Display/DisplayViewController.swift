@@ -45,6 +45,7 @@ class DisplayViewController:UIViewController {
 
     private func displayModel(model:DisplayModel) {
         self.configureRenderView(renderView: model.renderView)
+        self.configureRenderView(renderView: model.captureRenderView)
         self.viewModel.refreshDisplay()
     }
 
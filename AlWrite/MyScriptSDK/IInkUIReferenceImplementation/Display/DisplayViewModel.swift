@@ -17,17 +17,21 @@ class DisplayViewModel : NSObject {
     var renderer: IINKRenderer?
     var imageLoader: ImageLoader?
     private(set) var offscreenRenderSurfaces: OffscreenRenderSurfaces = OffscreenRenderSurfaces()
+    let inkLatencyMonitor: InkLatencyMonitor = InkLatencyMonitor()
     private var didSetConstraints: Bool = false
 
     func setupModel() {
         let model: DisplayModel = DisplayModel()
-        model.renderView.offscreenRenderSurfaces = offscreenRenderSurfaces
-        if let renderer {
-            model.renderView.renderer = renderer
-        }
-        if let imageLoader {
-            model.renderView.imageLoader = imageLoader
+        for renderView in model.renderViews {
+            renderView.offscreenRenderSurfaces = offscreenRenderSurfaces
+            if let renderer {
+                renderView.renderer = renderer
+            }
+            if let imageLoader {
+                renderView.imageLoader = imageLoader
+            }
         }
+        model.captureRenderView.inkLatencyMonitor = self.inkLatencyMonitor
         self.model = model
     }
 
@@ -38,13 +42,40 @@ class DisplayViewModel : NSObject {
     func initModelViewConstraints(view:UIView) {
         guard self.didSetConstraints == false, let model = self.model else { return }
         self.didSetConstraints = true
-        let views: [String: RenderView] = ["renderView" : model.renderView]
+        let views: [String: RenderView] = ["renderView" : model.renderView, "captureRenderView" : model.captureRenderView]
         view.addConstraints(NSLayoutConstraint.constraints(withVisualFormat: "H:|[renderView]|", options: .alignAllLeft, metrics: nil, views: views))
         view.addConstraints(NSLayoutConstraint.constraints(withVisualFormat: "V:|[renderView]|", options: .alignAllLeft, metrics: nil, views: views))
+        view.addConstraints(NSLayoutConstraint.constraints(withVisualFormat: "H:|[captureRenderView]|", options: .alignAllLeft, metrics: nil, views: views))
+        view.addConstraints(NSLayoutConstraint.constraints(withVisualFormat: "V:|[captureRenderView]|", options: .alignAllLeft, metrics: nil, views: views))
+    }
+
+    func viewOffsetDidChange(_ viewOffset:CGPoint) {
+        self.model?.renderView.viewOffsetDidChange(viewOffset)
     }
 
     func refreshDisplay() {
-        self.model?.renderView.setNeedsDisplay()
+        self.model?.renderViews.forEach { $0.invalidateAll() }
+    }
+}
+
+extension DisplayViewModel : IINKEditorDelegate {
+
+    func partChanged(_ editor: IINKEditor) {
+        self.contentDidChange()
+    }
+
+    func contentChanged(_ editor: IINKEditor, blockIds: [String]) {
+        self.contentDidChange()
+    }
+
+    func onError(_ editor: IINKEditor, blockId: String, message: String) {
+    }
+
+    /// Tells the views before the invalidation the change causes is handled, as both go through the main queue.
+    private func contentDidChange() {
+        DispatchQueue.main.async { [weak self] in
+            self?.model?.renderViews.forEach { $0.contentDidChange() }
+        }
     }
 }
 
@@ -52,13 +83,14 @@ extension DisplayViewModel : IINKIRenderTarget {
 
     func invalidate(_ renderer: IINKRenderer, layers: IINKLayerType) {
         DispatchQueue.main.async { [weak self] in
-            self?.model?.renderView.setNeedsDisplay()
+            // Each view only redraws for its own layer: new ink does not touch the model view
+            self?.model?.renderViews.forEach { $0.invalidate(layers: layers) }
         }
     }
 
     func invalidate(_ renderer: IINKRenderer, area: CGRect, layers: IINKLayerType) {
         DispatchQueue.main.async { [weak self] in
-            self?.model?.renderView.setNeedsDisplay(area)
+            self?.model?.renderViews.forEach { $0.invalidate(layers: layers, area: area) }
         }
     }
 
@@ -48,6 +48,7 @@ class EditorViewModel {
     private(set) var originalViewOffset: CGPoint = CGPoint.zero
     private weak var editorDelegate: EditorDelegate?
     private var editorDelegateTrampoline: EditorDelegateTrampoline
+    private weak var displayViewModel: DisplayViewModel?
     private weak var smartGuideDelegate: SmartGuideViewControllerDelegate?
     private var smartGuideDisabled: Bool = false
     private var didSetConstraints: Bool = false
@@ -67,6 +68,7 @@ class EditorViewModel {
     func setupModel(with panGesture: UIPanGestureRecognizer?) {
         let model = EditorModel()
         let displayViewModel = DisplayViewModel()
+        self.displayViewModel = displayViewModel
         self.initEditor(with: displayViewModel)
         model.displayViewController = DisplayViewController(viewModel: displayViewModel)
         if self.smartGuideDisabled == false {
@@ -77,6 +79,7 @@ class EditorViewModel {
         model.neboInputView = InputView(frame: CGRect.zero)
         model.neboInputView?.inputMode = self.inputMode
         model.neboInputView?.editor = self.editor
+        model.neboInputView?.inkLatencyMonitor = displayViewModel.inkLatencyMonitor
         if let panGesture = panGesture {
             model.neboInputView?.addGestureRecognizer(panGesture)
         }
@@ -137,7 +140,8 @@ class EditorViewModel {
         if state == UIGestureRecognizer.State.ended {
             self.originalViewOffset = self.editor?.renderer.viewOffset ?? CGPoint.zero
         }
-        NotificationCenter.default.post(name: DisplayViewController.refreshNotification, object: nil)
+        // The display composites its cached tiles at the new offset instead of redrawing everything
+        self.displayViewModel?.viewOffsetDidChange(newOffset)
     }
 
     func setEditorViewSize(size: CGSize) {
@@ -169,5 +173,7 @@ class EditorViewModel {
         target.imageLoader = ImageLoader()
 
         self.editor?.addDelegate(self.editorDelegateTrampoline)
+        // Lets the display tell content changes from scrolls
+        self.editor?.addDelegate(target)
     }
 }
@@ -17,7 +17,7 @@ import UIKit
     private var aTransform:CGAffineTransform = .identity
     private var style:IINKStyle = IINKStyle()
     private var clippedGroupIdentifier:[String] = []
-    private var fontAttributeDict:[NSAttributedString.Key : Any] = [NSAttributedString.Key : Any]()
+    private var fontStyle:FontStyle?
     private var cgRule:CGPathFillRule = .evenOdd
 }
 
@@ -30,7 +30,7 @@ extension Canvas : IINKICanvas {
             self.context = UIGraphicsGetCurrentContext()
         }
         self.aTransform = .identity
-        self.fontAttributeDict.removeAll()
+        self.fontStyle = nil
         self.context?.saveGState()
         //Enforce defaults
         self.style.setAllChangeFlags()
@@ -141,8 +141,8 @@ extension Canvas : IINKICanvas {
 
     func setFillColor(_ color: UInt32) {
         self.style.fillColor = color
+        // Also the color of text: shaped lines take the fill color of the context
         self.context?.setFillColor(IInkUIRefImplUtils.uiColor(rgba: color).cgColor)
-        self.fontAttributeDict[NSAttributedString.Key.foregroundColor] = IInkUIRefImplUtils.uiColor(rgba: color)
     }
 
     func setFillRule(_ rule: IINKFillRule) {
@@ -172,12 +172,7 @@ extension Canvas : IINKICanvas {
         self.style.fontVariant = variant
         self.style.fontWeight = Int(weight)
         self.style.fontStyle = style
-        let font:UIFont? = UIFont.fontFromStyle(style: self.style)
-        self.fontAttributeDict[NSAttributedString.Key.font] = font
-        self.fontAttributeDict[NSAttributedString.Key.ligature] = NSNumber(0)
-        let paragraphStyle:NSMutableParagraphStyle = NSMutableParagraphStyle()
-        paragraphStyle.lineSpacing = CGFloat(self.style.fontLineHeight)
-        self.fontAttributeDict[NSAttributedString.Key.paragraphStyle] = paragraphStyle
+        self.fontStyle = FontStyleTable.shared.style(for: FontStyleKey(family: family, size: size, weight: Int(weight), style: style, variant: variant, lineHeight: lineHeight))
     }
 
     // MARK: - Group Management
@@ -260,13 +255,11 @@ extension Canvas : IINKICanvas {
     }
 
     func drawText(_ label: String, anchor origin: CGPoint, region rect: CGRect) {
-        guard let context = self.context,
-              let font = UIFont.fontFromStyle(style: self.style,string: label) else {
-                  return
+        let fontStyle:FontStyle = self.fontStyle ?? FontStyleTable.shared.style(for: FontStyleKey(style: self.style))
+        guard let context = self.context, fontStyle.font != nil else {
+            return
         }
-        self.fontAttributeDict[NSAttributedString.Key.font] = font
-        let attrString:NSAttributedString = NSAttributedString(string: label, attributes: self.fontAttributeDict)
-        let line:CTLine = CTLineCreateWithAttributedString(attrString)
+        let line:CTLine = TextLineCache.shared.line(for: label, style: fontStyle)
         self.context?.textPosition = origin
         CTLineDraw(line, context)
     }
@@ -0,0 +1,218 @@
+// Copyright @ MyScript. All rights reserved.
+
+import Foundation
+import UIKit
+
+/// The DisplayList stores the canvas calls of one drawing pass, so the pass can be replayed on any IINKICanvas without asking the renderer to walk the model again. Commands are kept in `opcodes`, their numeric operands in the flat `scalars` buffer and their text operands in `strings`. Resetting a list keeps the capacity of its buffers, so recording a region again does not allocate.
+
+final class DisplayList {
+
+    enum Opcode : UInt8 {
+        case startDraw          // rect
+        case endDraw
+        case setTransform       // a, b, c, d, tx, ty
+        case setStrokeColor     // color
+        case setStrokeWidth     // width
+        case setLineCap         // raw value
+        case setLineJoin        // raw value
+        case setMiterLimit      // limit
+        case setDashArray       // count, values
+        case setDashOffset      // offset
+        case setFillColor       // color
+        case setFillRule        // raw value
+        case setDropShadow      // x offset, y offset, radius, color
+        case setFontProperties  // family, style, variant; line height, size, weight
+        case startGroup         // identifier; rect, clip flag
+        case endGroup           // identifier
+        case beginPath
+        case moveTo             // point
+        case lineTo             // point
+        case curveTo            // point, control point 1, control point 2
+        case quadTo             // point, control point
+        case closePath
+        case drawPath
+        case drawRectangle      // rect
+        case drawLine           // from, to
+        case drawObject         // url, mime type; rect
+        case drawText           // label; anchor, rect
+        case blendOffscreen     // offscreen id, source rect, destination rect, color
+    }
+
+    // MARK: - Properties
+
+    private(set) var opcodes:[Opcode] = []
+    private(set) var scalars:[Double] = []
+    private(set) var strings:[String] = []
+
+    var isEmpty:Bool {
+        return self.opcodes.isEmpty
+    }
+
+    /// Approximate memory held by the buffers, strings counted by their UTF-8 length.
+    var byteCount:Int {
+        return self.opcodes.capacity + self.scalars.capacity * MemoryLayout<Double>.stride + self.strings.reduce(0) { $0 + $1.utf8.count }
+    }
+
+    // MARK: - Recording
+
+    func reset() {
+        self.opcodes.removeAll(keepingCapacity: true)
+        self.scalars.removeAll(keepingCapacity: true)
+        self.strings.removeAll(keepingCapacity: true)
+    }
+
+    func append(_ opcode:Opcode) {
+        self.opcodes.append(opcode)
+    }
+
+    func append(_ opcode:Opcode, _ values:Double...) {
+        self.opcodes.append(opcode)
+        self.scalars.append(contentsOf: values)
+    }
+
+    func append(_ opcode:Opcode, rect:CGRect) {
+        self.append(opcode, Double(rect.origin.x), Double(rect.origin.y), Double(rect.width), Double(rect.height))
+    }
+
+    func append(segments:[Opcode], coordinates:[Double]) {
+        self.opcodes.append(contentsOf: segments)
+        self.scalars.append(contentsOf: coordinates)
+    }
+
+    func appendScalars(_ values:UnsafeBufferPointer<Float>) {
+        for value in values {
+            self.scalars.append(Double(value))
+        }
+    }
+
+    func appendString(_ string:String) {
+        self.strings.append(string)
+    }
+
+    // MARK: - Replay
+
+    func replay(on canvas:IINKICanvas) {
+        var reader = Reader(scalars: self.scalars, strings: self.strings)
+        var path:IINKIPath?
+
+        for opcode in self.opcodes {
+            switch opcode {
+            case .startDraw:
+                canvas.startDraw(in: reader.rect())
+            case .endDraw:
+                canvas.endDraw()
+            case .setTransform:
+                canvas.setTransform(CGAffineTransform(a: reader.cgFloat(), b: reader.cgFloat(), c: reader.cgFloat(), d: reader.cgFloat(), tx: reader.cgFloat(), ty: reader.cgFloat()))
+            case .setStrokeColor:
+                canvas.setStrokeColor(reader.color())
+            case .setStrokeWidth:
+                canvas.setStrokeWidth(reader.float())
+            case .setLineCap:
+                if let lineCap = IINKLineCap(rawValue: .init(reader.scalar())) {
+                    canvas.setStroke(lineCap)
+                }
+            case .setLineJoin:
+                if let lineJoin = IINKLineJoin(rawValue: .init(reader.scalar())) {
+                    canvas.setStroke(lineJoin)
+                }
+            case .setMiterLimit:
+                canvas.setStrokeMiterLimit(reader.float())
+            case .setDashArray:
+                let count = Int(reader.scalar())
+                let dashes:[Float] = (0..<count).map { _ in reader.float() }
+                dashes.withUnsafeBufferPointer { buffer in
+                    canvas.setStrokeDashArray(count > 0 ? buffer.baseAddress : nil, size: count)
+                }
+            case .setDashOffset:
+                canvas.setStrokeDashOffset(reader.float())
+            case .setFillColor:
+                canvas.setFillColor(reader.color())
+            case .setFillRule:
+                if let fillRule = IINKFillRule(rawValue: .init(reader.scalar())) {
+                    canvas.setFillRule(fillRule)
+                }
+            case .setDropShadow:
+                canvas.setDropShadow(reader.float(), yOffset: reader.float(), radius: reader.float(), color: reader.color())
+            case .setFontProperties:
+                let family = reader.string()
+                let style = reader.string()
+                let variant = reader.string()
+                canvas.setFontProperties(family, height: reader.float(), size: reader.float(), style: style, variant: variant, weight: Int32(reader.scalar()))
+            case .startGroup:
+                canvas.startGroup(reader.string(), region: reader.rect(), clip: reader.scalar() != 0)
+            case .endGroup:
+                canvas.endGroup(reader.string())
+            case .beginPath:
+                path = canvas.createPath()
+            case .moveTo:
+                path?.move(to: reader.point())
+            case .lineTo:
+                path?.line(to: reader.point())
+            case .curveTo:
+                path?.curve(to: reader.point(), controlPoint1: reader.point(), controlPoint2: reader.point())
+            case .quadTo:
+                path?.quad(to: reader.point(), controlPoint: reader.point())
+            case .closePath:
+                path?.close()
+            case .drawPath:
+                if let path = path {
+                    canvas.draw(path)
+                }
+                path = nil
+            case .drawRectangle:
+                canvas.drawRectangle(reader.rect())
+            case .drawLine:
+                canvas.drawLine(reader.point(), to: reader.point())
+            case .drawObject:
+                canvas.drawObject(reader.string(), mimeType: reader.string(), region: reader.rect())
+            case .drawText:
+                canvas.drawText(reader.string(), anchor: reader.point(), region: reader.rect())
+            case .blendOffscreen:
+                canvas.blendOffscreen(reader.color(), src: reader.rect(), dest: reader.rect(), color: reader.color())
+            }
+        }
+    }
+
+    /// Sequential cursor over the operand buffers. Operands are read in the order they were appended.
+    private struct Reader {
+        let scalars:[Double]
+        let strings:[String]
+        var scalarIndex:Int = 0
+        var stringIndex:Int = 0
+
+        init(scalars:[Double], strings:[String]) {
+            self.scalars = scalars
+            self.strings = strings
+        }
+
+        mutating func scalar() -> Double {
+            defer { self.scalarIndex += 1 }
+            return self.scalars[self.scalarIndex]
+        }
+
+        mutating func cgFloat() -> CGFloat {
+            return CGFloat(self.scalar())
+        }
+
+        mutating func float() -> Float {
+            return Float(self.scalar())
+        }
+
+        mutating func color() -> UInt32 {
+            return UInt32(self.scalar())
+        }
+
+        mutating func point() -> CGPoint {
+            return CGPoint(x: self.cgFloat(), y: self.cgFloat())
+        }
+
+        mutating func rect() -> CGRect {
+            return CGRect(x: self.cgFloat(), y: self.cgFloat(), width: self.cgFloat(), height: self.cgFloat())
+        }
+
+        mutating func string() -> String {
+            defer { self.stringIndex += 1 }
+            return self.strings[self.stringIndex]
+        }
+    }
+}
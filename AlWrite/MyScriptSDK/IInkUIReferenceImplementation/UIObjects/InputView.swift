@@ -16,6 +16,7 @@ class InputView : UIView {
     // MARK: - Properties
 
     weak var editor:IINKEditor?
+    weak var inkLatencyMonitor:InkLatencyMonitor?
     var inputMode:InputMode = .forcePen
     private var trackPressure:Bool = false
     private var cancelled:Bool = false
@@ -105,6 +106,7 @@ class InputView : UIView {
         if e.pointerType == .pen {
             self.touchesBegan = true
         }
+        self.inkLatencyMonitor?.inputReceived(at: touch.timestamp)
         let point = CGPoint(x: CGFloat(e.x), y: CGFloat(e.y))
         let _ = try? self.editor?.pointerDown(point: point, timestamp: e.t, force: e.f, type: e.pointerType, pointerId: Int(e.pointerId))
         self.cancelled = false
@@ -113,6 +115,7 @@ class InputView : UIView {
     override func touchesMoved(_ touches: Set<UITouch>, with event: UIEvent?) {
         super.touchesMoved(touches, with: event)
         guard let touch:UITouch = touches.randomElement() else { return }
+        self.inkLatencyMonitor?.inputReceived(at: touch.timestamp)
         let coalescedTouches:[UITouch]? = event?.coalescedTouches(for: touch)
         if let coalescedTouchesUnwrapped = coalescedTouches {
             var events:[IINKPointerEvent] = coalescedTouchesUnwrapped.map { coalescedTouch in
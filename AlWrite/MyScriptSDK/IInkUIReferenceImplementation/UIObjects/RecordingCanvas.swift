@@ -0,0 +1,209 @@
+// Copyright @ MyScript. All rights reserved.
+
+import Foundation
+import UIKit
+
+/// The RecordingCanvas is handed to the renderer instead of a Canvas when a region has to be drawn again. It does not draw anything: every call is appended to a DisplayList, which the RenderView then replays on its Canvas, and again on later redraws of the same region until the renderer invalidates it.
+
+@objcMembers class RecordingCanvas : NSObject {
+
+    // MARK: - Properties
+
+    let list:DisplayList
+    let size:CGSize
+    private var aTransform:CGAffineTransform = .identity
+
+    init(list:DisplayList, size:CGSize) {
+        self.list = list
+        self.size = size
+        super.init()
+    }
+}
+
+extension RecordingCanvas : IINKICanvas {
+
+    // MARK: - Drawing Session Management
+
+    func startDraw(in rect: CGRect) {
+        self.aTransform = .identity
+        self.list.append(.startDraw, rect: rect)
+    }
+
+    func endDraw() {
+        self.list.append(.endDraw)
+    }
+
+    // MARK: - View Properties
+
+    func getTransform() -> CGAffineTransform {
+        return self.aTransform
+    }
+
+    func setTransform(_ transform: CGAffineTransform) {
+        self.aTransform = transform
+        self.list.append(.setTransform, Double(transform.a), Double(transform.b), Double(transform.c), Double(transform.d), Double(transform.tx), Double(transform.ty))
+    }
+
+    // MARK: - Stroking Properties
+
+    func setStrokeColor(_ color: UInt32) {
+        self.list.append(.setStrokeColor, Double(color))
+    }
+
+    func setStrokeWidth(_ width: Float) {
+        self.list.append(.setStrokeWidth, Double(width))
+    }
+
+    func setStroke(_ lineCap: IINKLineCap) {
+        self.list.append(.setLineCap, Double(lineCap.rawValue))
+    }
+
+    func setStroke(_ lineJoin: IINKLineJoin) {
+        self.list.append(.setLineJoin, Double(lineJoin.rawValue))
+    }
+
+    func setStrokeMiterLimit(_ limit: Float) {
+        self.list.append(.setMiterLimit, Double(limit))
+    }
+
+    func setStrokeDashArray(_ array: UnsafePointer<Float>?, size: Int) {
+        let count = array == nil ? 0 : size
+        self.list.append(.setDashArray, Double(count))
+        if let array = array {
+            self.list.appendScalars(UnsafeBufferPointer<Float>(start: array, count: count))
+        }
+    }
+
+    func setStrokeDashOffset(_ offset: Float) {
+        self.list.append(.setDashOffset, Double(offset))
+    }
+
+    // MARK: - Filling Properties
+
+    func setFillColor(_ color: UInt32) {
+        self.list.append(.setFillColor, Double(color))
+    }
+
+    func setFillRule(_ rule: IINKFillRule) {
+        self.list.append(.setFillRule, Double(rule.rawValue))
+    }
+
+    // MARK: - Drop Shadow Properties
+
+    func setDropShadow(_ xOffset: Float, yOffset: Float, radius: Float, color: UInt32) {
+        self.list.append(.setDropShadow, Double(xOffset), Double(yOffset), Double(radius), Double(color))
+    }
+
+    // MARK: - Font Properties
+
+    func setFontProperties(_ family: String, height lineHeight: Float, size: Float, style: String, variant: String, weight: Int32) {
+        self.list.appendString(family)
+        self.list.appendString(style)
+        self.list.appendString(variant)
+        self.list.append(.setFontProperties, Double(lineHeight), Double(size), Double(weight))
+    }
+
+    // MARK: - Group Management
+
+    func startGroup(_ identifier: String, region: CGRect, clip clipContent: Bool) {
+        self.list.appendString(identifier)
+        self.list.append(.startGroup, Double(region.origin.x), Double(region.origin.y), Double(region.width), Double(region.height), clipContent ? 1 : 0)
+    }
+
+    func endGroup(_ identifier: String) {
+        self.list.appendString(identifier)
+        self.list.append(.endGroup)
+    }
+
+    // Items carry no drawing state for the Canvas, so they are not recorded.
+    func startItem(_ identifier: String) {
+
+    }
+
+    func endItem(_ identifier: String) {
+
+    }
+
+    // MARK: - Drawing commands
+
+    func createPath() -> IINKIPath {
+        return RecordingPath()
+    }
+
+    func draw(_ path: IINKIPath) {
+        guard let aPath:RecordingPath = path as? RecordingPath else { return }
+        self.list.append(.beginPath)
+        aPath.write(to: self.list)
+        self.list.append(.drawPath)
+    }
+
+    func drawRectangle(_ rect: CGRect) {
+        self.list.append(.drawRectangle, rect: rect)
+    }
+
+    func drawLine(_ from: CGPoint, to: CGPoint) {
+        self.list.append(.drawLine, Double(from.x), Double(from.y), Double(to.x), Double(to.y))
+    }
+
+    func drawObject(_ url: String, mimeType: String, region rect: CGRect) {
+        self.list.appendString(url)
+        self.list.appendString(mimeType)
+        self.list.append(.drawObject, rect: rect)
+    }
+
+    func drawText(_ label: String, anchor origin: CGPoint, region rect: CGRect) {
+        self.list.appendString(label)
+        self.list.append(.drawText, Double(origin.x), Double(origin.y), Double(rect.origin.x), Double(rect.origin.y), Double(rect.width), Double(rect.height))
+    }
+
+    func blendOffscreen(_ offscreenId: UInt32, src: CGRect, dest: CGRect, color: UInt32) {
+        self.list.append(.blendOffscreen, Double(offscreenId),
+                         Double(src.origin.x), Double(src.origin.y), Double(src.width), Double(src.height),
+                         Double(dest.origin.x), Double(dest.origin.y), Double(dest.width), Double(dest.height),
+                         Double(color))
+    }
+}
+
+/// Path handed out by the RecordingCanvas. Segments are kept as opcodes and coordinates until the path is drawn, then copied into the display list.
+
+class RecordingPath : NSObject, IINKIPath {
+
+    private var segments:[DisplayList.Opcode] = []
+    private var coordinates:[Double] = []
+
+    func move(to position: CGPoint) {
+        self.segments.append(.moveTo)
+        self.appendPoint(position)
+    }
+
+    func line(to position: CGPoint) {
+        self.segments.append(.lineTo)
+        self.appendPoint(position)
+    }
+
+    func close() {
+        self.segments.append(.closePath)
+    }
+
+    func curve(to: CGPoint, controlPoint1 c1: CGPoint, controlPoint2 c2: CGPoint) {
+        self.segments.append(.curveTo)
+        self.appendPoint(to)
+        self.appendPoint(c1)
+        self.appendPoint(c2)
+    }
+
+    func quad(to: CGPoint, controlPoint c: CGPoint) {
+        self.segments.append(.quadTo)
+        self.appendPoint(to)
+        self.appendPoint(c)
+    }
+
+    func write(to list:DisplayList) {
+        list.append(segments: self.segments, coordinates: self.coordinates)
+    }
+
+    private func appendPoint(_ point:CGPoint) {
+        self.coordinates.append(Double(point.x))
+        self.coordinates.append(Double(point.y))
+    }
+}
@@ -0,0 +1,144 @@
+// Copyright @ MyScript. All rights reserved.
+
+import Foundation
+import UIKit
+
+/// Position of a tile: the zoom it was rendered at, its column and row in the scrolled content, and the layer it shows.
+
+struct RenderTileKey : Hashable {
+    let zoom:Float
+    let column:Int
+    let row:Int
+    let layer:UInt
+}
+
+/// A fixed-size piece of a rendered layer. `documentRect` is in content coordinates, that is view coordinates plus the renderer's view offset, so a tile stays valid while the view scrolls.
+
+final class RenderTile {
+
+    let key:RenderTileKey
+    let documentRect:CGRect
+    /// Bumped by every invalidation that touches the tile.
+    fileprivate(set) var version:Int = 0
+    fileprivate(set) var renderedVersion:Int = -1
+    fileprivate(set) var image:UIImage?
+    fileprivate(set) var lastUse:UInt64 = 0
+    /// Queued by its RenderView for rendering.
+    var isPending:Bool = false
+
+    var isCurrent:Bool {
+        return self.image != nil && self.renderedVersion == self.version
+    }
+
+    fileprivate var byteCount:Int {
+        guard let cgImage = self.image?.cgImage else { return 0 }
+        return cgImage.bytesPerRow * cgImage.height
+    }
+
+    fileprivate init(key:RenderTileKey, documentRect:CGRect) {
+        self.key = key
+        self.documentRect = documentRect
+    }
+}
+
+/// The RenderTileCache is the backing store of a RenderView. It keeps the rendered tiles of each layer and tracks which ones the render target invalidated since they were drawn. It is only used from the main thread; the RenderView renders tiles and hands them back with `store(_:for:version:)`.
+
+final class RenderTileCache {
+
+    static let tileSize:CGFloat = 256
+
+    // MARK: - Properties
+
+    /// Memory allowed for tile images; the least recently drawn tiles are dropped beyond it.
+    let byteBudget:Int
+    private var tiles:[RenderTileKey:RenderTile] = [:]
+    private var byteCount:Int = 0
+    private var useCounter:UInt64 = 0
+
+    init(byteBudget:Int = 48 * 1024 * 1024) {
+        self.byteBudget = byteBudget
+    }
+
+    // MARK: - Lookup
+
+    /// Tiles of `layer` covering `documentRect` at `zoom`, created on demand, in row order.
+    func tiles(covering documentRect:CGRect, zoom:Float, layer:IINKLayerType) -> [RenderTile] {
+        guard !documentRect.isEmpty else { return [] }
+        let size:CGFloat = RenderTileCache.tileSize
+        let firstColumn = Int((documentRect.minX / size).rounded(.down))
+        let lastColumn = Int((documentRect.maxX / size).rounded(.up)) - 1
+        let firstRow = Int((documentRect.minY / size).rounded(.down))
+        let lastRow = Int((documentRect.maxY / size).rounded(.up)) - 1
+        guard firstColumn <= lastColumn, firstRow <= lastRow else { return [] }
+
+        var result:[RenderTile] = []
+        result.reserveCapacity((lastColumn - firstColumn + 1) * (lastRow - firstRow + 1))
+        for row in firstRow...lastRow {
+            for column in firstColumn...lastColumn {
+                let key = RenderTileKey(zoom: zoom, column: column, row: row, layer: UInt(layer.rawValue))
+                let tile:RenderTile
+                if let existing = self.tiles[key] {
+                    tile = existing
+                } else {
+                    tile = RenderTile(key: key, documentRect: CGRect(x: CGFloat(column) * size, y: CGFloat(row) * size, width: size, height: size))
+                    self.tiles[key] = tile
+                }
+                self.useCounter += 1
+                tile.lastUse = self.useCounter
+                result.append(tile)
+            }
+        }
+        return result
+    }
+
+    // MARK: - Rendering
+
+    /// Keeps `image` if no invalidation reached the tile since `version` was read.
+    func store(_ image:UIImage, for tile:RenderTile, version:Int) {
+        guard self.tiles[tile.key] === tile, tile.version == version else { return }
+        self.byteCount -= tile.byteCount
+        tile.image = image
+        tile.renderedVersion = version
+        self.byteCount += tile.byteCount
+        self.evictIfNeeded()
+    }
+
+    // MARK: - Invalidation
+
+    func invalidate(layers:IINKLayerType) {
+        for tile in self.tiles.values where IINKLayerType(rawValue: .init(tile.key.layer)).isSubset(of: layers) {
+            tile.version += 1
+        }
+    }
+
+    /// `documentArea` is expressed at `zoom`; tiles of other zooms cannot be matched against it and are dropped.
+    func invalidate(layers:IINKLayerType, documentArea:CGRect, zoom:Float) {
+        for (key, tile) in self.tiles where IINKLayerType(rawValue: .init(key.layer)).isSubset(of: layers) {
+            if key.zoom != zoom {
+                self.remove(key)
+            } else if tile.documentRect.intersects(documentArea) {
+                tile.version += 1
+            }
+        }
+    }
+
+    func removeAll() {
+        self.tiles.removeAll()
+        self.byteCount = 0
+    }
+
+    // MARK: - Private Helpers
+
+    private func remove(_ key:RenderTileKey) {
+        guard let tile = self.tiles.removeValue(forKey: key) else { return }
+        self.byteCount -= tile.byteCount
+    }
+
+    private func evictIfNeeded() {
+        guard self.byteCount > self.byteBudget else { return }
+        let leastRecentlyUsed = self.tiles.values.filter { $0.image != nil }.sorted { $0.lastUse < $1.lastUse }
+        for tile in leastRecentlyUsed where self.byteCount > self.byteBudget {
+            self.remove(tile.key)
+        }
+    }
+}
@@ -3,33 +3,56 @@
 import Foundation
 import UIKit
 
-/// The RenderView role is to render (hence its name) the different strokes, using a Canvas and a Renderer. For performance reasons, there are two types of RenderView, layer or capture. One is used to display live capturing stroke, and the other is used to diplay the recorded strokes (the model).
+/// The RenderView role is to render (hence its name) the different strokes, using a Canvas and a Renderer. For performance reasons, there are two types of RenderView, layer or capture. One is used to display live capturing stroke, and the other is used to diplay the recorded strokes (the model). The model is kept in a RenderTileCache, so scrolling and capture updates composite tiles instead of asking the renderer to draw it again.
+/// The capture view only redraws the areas the renderer invalidates. While a stroke is being written these are the bounds of its newest segments, so each pass adds the new segments on top of the pixels already drawn rather than drawing the whole stroke again.
+/// The renderer is only used from the main thread. Tiles are rendered there too, within a time budget per pass; tiles left over are rendered on later run loop turns.
 
 class RenderView : UIView {
 
     // MARK: - Properties
 
+    /// Time a draw pass, or a later run loop turn, may spend rendering tiles.
+    static let tileRenderingBudget:TimeInterval = 0.004
+
+    let layerType:IINKLayerType
     weak var renderer:IINKRenderer?
+    weak var inkLatencyMonitor:InkLatencyMonitor?
     weak var imageLoader:ImageLoader? {
         didSet {
             self.canvas.imageLoader = self.imageLoader
+            self.tileCanvas.imageLoader = self.imageLoader
         }
     }
     weak var offscreenRenderSurfaces:OffscreenRenderSurfaces? {
         didSet {
             self.canvas.offscreenRenderSurfaces = self.offscreenRenderSurfaces
+            self.tileCanvas.offscreenRenderSurfaces = self.offscreenRenderSurfaces
         }
     }
     private var canvas:Canvas = Canvas()
+    private let tiles:RenderTileCache = RenderTileCache()
+    private let tileCanvas:Canvas = Canvas()
+    /// Tiles waiting to be rendered, in the order they were asked for.
+    private var pendingTiles:[RenderTile] = []
+    private var isTileRenderingScheduled:Bool = false
+    /// View offset at the last full invalidation, and whether the editor reported a content change since.
+    private var invalidatedViewOffset:CGPoint?
+    private var hasContentChanged:Bool = false
 
     // MARK: - Init
 
-    override init(frame: CGRect) {
+    init(frame: CGRect, layerType: IINKLayerType) {
+        self.layerType = layerType
         super.init(frame: frame)
         self.ownInit()
     }
 
+    override convenience init(frame: CGRect) {
+        self.init(frame: frame, layerType: .model)
+    }
+
     required init?(coder: NSCoder) {
+        self.layerType = .model
         super.init(coder: coder)
         self.ownInit()
     }
@@ -49,7 +72,151 @@ class RenderView : UIView {
         self.canvas.context = UIGraphicsGetCurrentContext()
         self.canvas.size = self.bounds.size
         self.canvas.clearAtStartDraw = false
-        self.renderer?.drawModel(rect, canvas: self.canvas)
-        self.renderer?.drawCaptureStrokes(rect, canvas: self.canvas)
+        guard let renderer = self.renderer else { return }
+        if self.layerType.contains(.model) {
+            self.drawModelTiles(rect, renderer: renderer)
+        }
+        if self.layerType.contains(.capture) {
+            renderer.drawCaptureStrokes(rect, canvas: self.canvas)
+            self.inkLatencyMonitor?.inkDrawn()
+        }
+    }
+
+    private func drawModelTiles(_ rect:CGRect, renderer:IINKRenderer) {
+        let viewOffset:CGPoint = renderer.viewOffset
+        let zoom:Float = renderer.viewScale
+        let deadline:CFAbsoluteTime = CFAbsoluteTimeGetCurrent() + RenderView.tileRenderingBudget
+
+        // Missing tiles are rendered and composited while the budget lasts. Past it, the rest of the rect is drawn directly and its tiles wait for a later turn.
+        var missingRect:CGRect = .null
+        for tile in self.tiles.tiles(covering: rect.offsetBy(dx: viewOffset.x, dy: viewOffset.y), zoom: zoom, layer: .model) {
+            if !tile.isCurrent, CFAbsoluteTimeGetCurrent() < deadline {
+                self.render(tile, renderer: renderer)
+            }
+            let tileRect:CGRect = tile.documentRect.offsetBy(dx: -viewOffset.x, dy: -viewOffset.y)
+            if tile.isCurrent, let image = tile.image {
+                image.draw(in: tileRect)
+            } else {
+                missingRect = missingRect.union(tileRect.intersection(rect))
+                self.enqueue(tile)
+            }
+        }
+        if !missingRect.isNull {
+            renderer.drawModel(missingRect, canvas: self.canvas)
+        }
+        self.prefetchTiles(around: rect, viewOffset: viewOffset, zoom: zoom)
+    }
+
+    // MARK: - Tiles
+
+    /// Queues the tiles next to the drawn rect as well, so that scrolling finds them ready.
+    private func prefetchTiles(around rect:CGRect, viewOffset:CGPoint, zoom:Float) {
+        let margin:CGFloat = RenderTileCache.tileSize
+        let prefetchRect:CGRect = rect.insetBy(dx: -margin, dy: -margin).intersection(self.bounds.insetBy(dx: -margin, dy: -margin))
+        for tile in self.tiles.tiles(covering: prefetchRect.offsetBy(dx: viewOffset.x, dy: viewOffset.y), zoom: zoom, layer: .model) where !tile.isCurrent {
+            self.enqueue(tile)
+        }
+    }
+
+    private func enqueue(_ tile:RenderTile) {
+        guard !tile.isPending else { return }
+        tile.isPending = true
+        self.pendingTiles.append(tile)
+        self.scheduleTileRendering()
+    }
+
+    private func scheduleTileRendering() {
+        guard !self.isTileRenderingScheduled, !self.pendingTiles.isEmpty else { return }
+        self.isTileRenderingScheduled = true
+        DispatchQueue.main.async { [weak self] in
+            self?.renderPendingTiles()
+        }
+    }
+
+    /// Renders queued tiles until the budget is spent, then yields so that touches and display updates go first.
+    private func renderPendingTiles() {
+        self.isTileRenderingScheduled = false
+        guard let renderer = self.renderer else {
+            self.removePendingTiles()
+            return
+        }
+        let deadline:CFAbsoluteTime = CFAbsoluteTimeGetCurrent() + RenderView.tileRenderingBudget
+        while !self.pendingTiles.isEmpty, CFAbsoluteTimeGetCurrent() < deadline {
+            let tile:RenderTile = self.pendingTiles.removeFirst()
+            tile.isPending = false
+            if !tile.isCurrent, tile.key.zoom == renderer.viewScale {
+                self.render(tile, renderer: renderer)
+            }
+        }
+        self.scheduleTileRendering()
+    }
+
+    /// The renderer draws in view coordinates, so the tile is placed with the current view offset.
+    private func render(_ tile:RenderTile, renderer:IINKRenderer) {
+        let version:Int = tile.version
+        let viewOffset:CGPoint = renderer.viewOffset
+        let tileRect:CGRect = tile.documentRect.offsetBy(dx: -viewOffset.x, dy: -viewOffset.y)
+        let format:UIGraphicsImageRendererFormat = UIGraphicsImageRendererFormat()
+        format.scale = self.contentScaleFactor
+        format.opaque = false
+        format.preferredRange = .standard
+
+        let image:UIImage = UIGraphicsImageRenderer(size: tile.documentRect.size, format: format).image { rendererContext in
+            rendererContext.cgContext.translateBy(x: -tileRect.origin.x, y: -tileRect.origin.y)
+            self.tileCanvas.context = rendererContext.cgContext
+            self.tileCanvas.size = self.bounds.size
+            self.tileCanvas.clearAtStartDraw = false
+            renderer.drawModel(tileRect, canvas: self.tileCanvas)
+            self.tileCanvas.context = nil
+        }
+        self.tiles.store(image, for: tile, version: version)
+    }
+
+    private func removePendingTiles() {
+        self.pendingTiles.forEach { $0.isPending = false }
+        self.pendingTiles.removeAll()
+    }
+
+    // MARK: - Invalidation
+
+    /// Tells the view the renderer was scrolled to `viewOffset`. Tiles follow the content and are kept.
+    func viewOffsetDidChange(_ viewOffset:CGPoint) {
+        self.setNeedsDisplay()
+    }
+
+    /// Tells the view the editor changed the content, so the next full invalidation is not only a scroll.
+    func contentDidChange() {
+        self.hasContentChanged = true
+    }
+
+    /// Layers other than `layerType` are ignored.
+    func invalidate(layers:IINKLayerType) {
+        let layers:IINKLayerType = layers.intersection(self.layerType)
+        guard !layers.isEmpty else { return }
+        // The renderer invalidates everything when it scrolls: a full invalidation at a new offset, with no content change reported since the previous one, leaves the tiles alone.
+        let viewOffset:CGPoint? = self.renderer?.viewOffset
+        let isScroll:Bool = !self.hasContentChanged && self.invalidatedViewOffset != nil && viewOffset != self.invalidatedViewOffset
+        self.invalidatedViewOffset = viewOffset
+        self.hasContentChanged = false
+        if !isScroll {
+            self.tiles.invalidate(layers: layers)
+        }
+        self.setNeedsDisplay()
+    }
+
+    func invalidate(layers:IINKLayerType, area:CGRect) {
+        let layers:IINKLayerType = layers.intersection(self.layerType)
+        guard !layers.isEmpty else { return }
+        if let renderer = self.renderer {
+            let viewOffset:CGPoint = renderer.viewOffset
+            self.tiles.invalidate(layers: layers, documentArea: area.offsetBy(dx: viewOffset.x, dy: viewOffset.y), zoom: renderer.viewScale)
+        }
+        self.setNeedsDisplay(area)
+    }
+
+    func invalidateAll() {
+        self.tiles.removeAll()
+        self.removePendingTiles()
+        self.setNeedsDisplay()
     }
 }
@@ -0,0 +1,137 @@
+// Copyright @ MyScript. All rights reserved.
+
+import Foundation
+import UIKit
+import CoreText
+
+/// Font properties as the renderer sets them on a canvas.
+
+struct FontStyleKey : Hashable {
+    let family:String
+    let size:Float
+    let weight:Int
+    let style:String
+    let variant:String
+    let lineHeight:Float
+
+    init(family:String, size:Float, weight:Int, style:String, variant:String, lineHeight:Float) {
+        self.family = family
+        self.size = size
+        self.weight = weight
+        self.style = style
+        self.variant = variant
+        self.lineHeight = lineHeight
+    }
+
+    init(style:IINKStyle) {
+        self.init(family: style.fontFamily ?? "", size: style.fontSize, weight: style.fontWeight, style: style.fontStyle, variant: style.fontVariant, lineHeight: style.fontLineHeight)
+    }
+}
+
+/// An interned text style: the font and the attributes used to shape text with it. The text color is not part of the attributes; lines take the fill color of the context they are drawn in, so one shaped line serves every color.
+
+final class FontStyle {
+    let identifier:Int
+    let font:UIFont?
+    let attributes:[NSAttributedString.Key : Any]
+
+    fileprivate init(identifier:Int, key:FontStyleKey) {
+        self.identifier = identifier
+        let style:IINKStyle = IINKStyle()
+        style.fontFamily = key.family
+        style.fontSize = key.size
+        style.fontWeight = key.weight
+        style.fontStyle = key.style
+        style.fontVariant = key.variant
+        style.fontLineHeight = key.lineHeight
+        self.font = UIFont.fontFromStyle(style: style)
+        let paragraphStyle:NSMutableParagraphStyle = NSMutableParagraphStyle()
+        paragraphStyle.lineSpacing = CGFloat(key.lineHeight)
+        var attributes:[NSAttributedString.Key : Any] = [
+            NSAttributedString.Key.ligature : NSNumber(0),
+            NSAttributedString.Key.paragraphStyle : paragraphStyle.copy(),
+            NSAttributedString.Key(kCTForegroundColorFromContextAttributeName as String) : true
+        ]
+        attributes[NSAttributedString.Key.font] = self.font
+        self.attributes = attributes
+    }
+}
+
+/// The FontStyleTable creates each FontStyle once. The renderer sets the same few font properties over and over while drawing a page, so looking them up here replaces a font lookup and a paragraph style allocation per call. It is shared by the canvases, which draw on the main thread, and by the font metrics provider, which the engine may call from its own threads during layout; hence the lock.
+
+final class FontStyleTable {
+
+    static let shared:FontStyleTable = FontStyleTable()
+
+    private var styles:[FontStyleKey:FontStyle] = [:]
+
+    func style(for key:FontStyleKey) -> FontStyle {
+        return synchronized(lock: self) {
+            if let style = self.styles[key] {
+                return style
+            }
+            let style:FontStyle = FontStyle(identifier: self.styles.count, key: key)
+            self.styles[key] = style
+            return style
+        }
+    }
+}
+
+/// The TextLineCache keeps the most recently drawn CTLines by label and style, so labels that are drawn again on every redraw are shaped once.
+
+final class TextLineCache {
+
+    static let shared:TextLineCache = TextLineCache()
+
+    private struct Key : Hashable {
+        let label:String
+        let styleIdentifier:Int
+    }
+
+    private struct Entry {
+        let line:CTLine
+        var lastUse:UInt64
+    }
+
+    let capacity:Int
+    private var entries:[Key:Entry] = [:]
+    private var useCounter:UInt64 = 0
+
+    init(capacity:Int = 1024) {
+        self.capacity = capacity
+    }
+
+    func line(for label:String, style:FontStyle) -> CTLine {
+        let key:Key = Key(label: label, styleIdentifier: style.identifier)
+        return synchronized(lock: self) {
+            self.useCounter += 1
+            if var entry = self.entries[key] {
+                entry.lastUse = self.useCounter
+                self.entries[key] = entry
+                return entry.line
+            }
+            let line:CTLine = CTLineCreateWithAttributedString(NSAttributedString(string: label, attributes: style.attributes))
+            self.entries[key] = Entry(line: line, lastUse: self.useCounter)
+            if self.entries.count > self.capacity {
+                self.evictLeastRecentlyUsed()
+            }
+            return line
+        }
+    }
+
+    func removeAll() {
+        synchronized(self) {
+            self.entries.removeAll()
+        }
+    }
+
+    // MARK: - Private Helpers
+
+    /// Drops the older quarter at once, so eviction does not sort on every new line.
+    private func evictLeastRecentlyUsed() {
+        let sorted = self.entries.sorted { $0.value.lastUse < $1.value.lastUse }
+        for (key, _) in sorted.prefix(max(1, self.capacity / 4)) {
+            self.entries.removeValue(forKey: key)
+        }
+    }
+}
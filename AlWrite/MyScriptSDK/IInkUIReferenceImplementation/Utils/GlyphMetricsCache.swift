@@ -0,0 +1,223 @@
+// Copyright @ MyScript. All rights reserved.
+
+import Foundation
+import CoreText
+
+/// Metrics of the glyphs of one shaped line, in flat arrays indexed by glyph.
+
+struct LineGlyphMetrics {
+    var boundingBoxes:[CGRect] = []
+    var leftSideBearings:[CGFloat] = []
+    var rightSideBearings:[CGFloat] = []
+
+    var count:Int {
+        return self.boundingBoxes.count
+    }
+
+    fileprivate mutating func reserveCapacity(_ capacity:Int) {
+        self.boundingBoxes.reserveCapacity(capacity)
+        self.leftSideBearings.reserveCapacity(capacity)
+        self.rightSideBearings.reserveCapacity(capacity)
+    }
+}
+
+/// The GlyphMetricsCache keeps the bounding rect and advance of every glyph it has seen, per font. The engine asks for the metrics of the same labels again and again during layout and reflow; only glyph positions depend on the line, so a run whose glyphs are all known is measured without calling the font at all.
+/// The metrics of the most recently measured lines are kept as well, by string and attributes, so a label asked for again is not shaped again either. Shaping remains the cost of a label seen for the first time.
+
+final class GlyphMetricsCache {
+
+    struct Statistics {
+        var calls:Int = 0
+        var lineHits:Int = 0
+        var glyphHits:Int = 0
+        var glyphMisses:Int = 0
+        var cachedRuns:Int = 0
+        var totalRuns:Int = 0
+        var totalTime:TimeInterval = 0
+
+        var lineHitRate:Double {
+            return self.calls == 0 ? 0 : Double(self.lineHits) / Double(self.calls)
+        }
+
+        var hitRate:Double {
+            let total = self.glyphHits + self.glyphMisses
+            return total == 0 ? 0 : Double(self.glyphHits) / Double(total)
+        }
+
+        var timePerCall:TimeInterval {
+            return self.calls == 0 ? 0 : self.totalTime / Double(self.calls)
+        }
+    }
+
+    private struct FontKey : Hashable {
+        let name:String
+        let size:CGFloat
+    }
+
+    /// Metrics of one font. `slots` is indexed by glyph id and points into `boundingRects` and `advances`, or is -1 for a glyph not measured yet.
+    private final class FontTable {
+        var slots:[Int32] = []
+        var boundingRects:[CGRect] = []
+        var advances:[CGFloat] = []
+
+        func slot(of glyph:CGGlyph) -> Int {
+            let index = Int(glyph)
+            return index < self.slots.count ? Int(self.slots[index]) : -1
+        }
+
+        func insert(_ glyph:CGGlyph, boundingRect:CGRect, advance:CGFloat) {
+            let index = Int(glyph)
+            if index >= self.slots.count {
+                self.slots.append(contentsOf: repeatElement(-1, count: index - self.slots.count + 1))
+            }
+            self.slots[index] = Int32(self.boundingRects.count)
+            self.boundingRects.append(boundingRect)
+            self.advances.append(advance)
+        }
+    }
+
+    private struct LineEntry {
+        let metrics:LineGlyphMetrics
+        var lastUse:UInt64
+    }
+
+    // MARK: - Properties
+
+    var isEnabled:Bool = true
+    /// Number of lines whose metrics are kept.
+    let lineCapacity:Int
+    private var fonts:[FontKey:FontTable] = [:]
+    private var lines:[NSAttributedString:LineEntry] = [:]
+    private var useCounter:UInt64 = 0
+    private var stats:Statistics = Statistics()
+
+    init(lineCapacity:Int = 2048) {
+        self.lineCapacity = lineCapacity
+    }
+
+    var statistics:Statistics {
+        return synchronized(lock: self) { self.stats }
+    }
+
+    // MARK: - Metrics
+
+    func metrics(for attributedString:NSAttributedString) -> LineGlyphMetrics {
+        let start:CFAbsoluteTime = CFAbsoluteTimeGetCurrent()
+        // Attributed strings compare by string and attributes; the copy keeps a mutable argument from changing the key
+        let key:NSAttributedString = attributedString.copy() as! NSAttributedString
+        let cached:LineGlyphMetrics? = synchronized(lock: self) {
+            guard self.isEnabled, var entry = self.lines[key] else { return nil }
+            self.useCounter += 1
+            entry.lastUse = self.useCounter
+            self.lines[key] = entry
+            self.stats.calls += 1
+            self.stats.lineHits += 1
+            self.stats.totalTime += CFAbsoluteTimeGetCurrent() - start
+            return entry.metrics
+        }
+        if let cached = cached {
+            return cached
+        }
+
+        var result:LineGlyphMetrics = LineGlyphMetrics()
+        let line:CTLine = CTLineCreateWithAttributedString(key)
+        guard let runs = CTLineGetGlyphRuns(line) as? [CTRun] else {
+            return result
+        }
+        result.reserveCapacity(CTLineGetGlyphCount(line))
+
+        synchronized(self) {
+            for run in runs {
+                guard let font = run.font else { continue }
+                self.appendMetrics(of: run, font: font, to: &result)
+            }
+            if self.isEnabled {
+                self.store(result, for: key)
+            }
+            self.stats.calls += 1
+            self.stats.totalTime += CFAbsoluteTimeGetCurrent() - start
+        }
+        return result
+    }
+
+    func removeAll() {
+        synchronized(self) {
+            self.fonts.removeAll()
+            self.lines.removeAll()
+        }
+    }
+
+    func resetStatistics() {
+        synchronized(self) {
+            self.stats = Statistics()
+        }
+    }
+
+    // MARK: - Private Helpers
+
+    private func appendMetrics(of run:CTRun, font:CTFont, to result:inout LineGlyphMetrics) {
+        let glyphs:[CGGlyph] = run.glyphs()
+        let positions:[CGPoint] = run.positions()
+        let table:FontTable = self.table(for: font)
+        self.stats.totalRuns += 1
+
+        var missing:[CGGlyph] = []
+        if self.isEnabled {
+            // The set keeps each unknown glyph queued once without scanning `missing` for every glyph of the run
+            var queued:Set<CGGlyph> = []
+            for glyph in glyphs where table.slot(of: glyph) < 0 && queued.insert(glyph).inserted {
+                missing.append(glyph)
+            }
+        } else {
+            table.slots.removeAll()
+            table.boundingRects.removeAll()
+            table.advances.removeAll()
+            missing = Array(Set(glyphs))
+        }
+        if missing.isEmpty {
+            self.stats.cachedRuns += 1
+        } else {
+            // One call per run for the glyphs not measured yet
+            let boundingRects:[CGRect] = run.boundingRects(for: missing, in: font)
+            let advances:[CGSize] = run.advances(for: missing, in: font)
+            for i in 0..<missing.count {
+                table.insert(missing[i], boundingRect: boundingRects[i], advance: advances[i].width)
+            }
+        }
+        let hits:Int = self.isEnabled ? glyphs.count - missing.count : 0
+        self.stats.glyphHits += hits
+        self.stats.glyphMisses += glyphs.count - hits
+
+        for i in 0..<glyphs.count {
+            let slot:Int = table.slot(of: glyphs[i])
+            let origin:CGPoint = table.boundingRects[slot].origin
+            let size:CGSize = table.boundingRects[slot].size
+            let advance:CGFloat = table.advances[slot]
+            result.boundingBoxes.append(CGRect(x: positions[i].x + origin.x, y: -origin.y - size.height, width: size.width, height: size.height))
+            result.leftSideBearings.append(-origin.x)
+            result.rightSideBearings.append(advance - (origin.x + size.width))
+        }
+    }
+
+    private func store(_ metrics:LineGlyphMetrics, for key:NSAttributedString) {
+        self.useCounter += 1
+        self.lines[key] = LineEntry(metrics: metrics, lastUse: self.useCounter)
+        if self.lines.count > self.lineCapacity {
+            // Drops the older quarter at once, so eviction does not sort on every new line
+            let sorted = self.lines.sorted { $0.value.lastUse < $1.value.lastUse }
+            for (key, _) in sorted.prefix(max(1, self.lineCapacity / 4)) {
+                self.lines.removeValue(forKey: key)
+            }
+        }
+    }
+
+    private func table(for font:CTFont) -> FontTable {
+        let key:FontKey = FontKey(name: CTFontCopyPostScriptName(font) as String, size: CTFontGetSize(font))
+        if let table = self.fonts[key] {
+            return table
+        }
+        let table:FontTable = FontTable()
+        self.fonts[key] = table
+        return table
+    }
+}
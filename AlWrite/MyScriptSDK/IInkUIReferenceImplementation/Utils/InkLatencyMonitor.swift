@@ -0,0 +1,144 @@
+// Copyright @ MyScript. All rights reserved.
+
+import Foundation
+import UIKit
+import os
+
+/// The InkLatencyMonitor measures how long new ink takes to reach the screen. The InputView reports the timestamp of each touch it forwards to the editor, and the capture RenderView reports each pass that draws ink. Two delays are measured from the oldest touch not drawn yet: until the capture layer has drawn it, and until the display refresh expected to show that drawing. Touch timestamps and display link timestamps use the same clock, the system uptime.
+/// Every `reportInterval` samples the summary is emitted as an "InkLatency" signpost event, visible in Instruments under the Ink category, and printed as well when the app is launched with `ALWRITE_INK_LATENCY_LOG` set.
+
+class InkLatencyMonitor : NSObject {
+
+    struct Summary {
+        let sampleCount:Int
+        let drawMedian:TimeInterval
+        let draw95thPercentile:TimeInterval
+        let presentMedian:TimeInterval
+        let present95thPercentile:TimeInterval
+
+        var description:String {
+            return String(format: "ink latency over %d samples: drawn p50 %.1f ms, p95 %.1f ms; on screen p50 %.1f ms, p95 %.1f ms",
+                          self.sampleCount, self.drawMedian * 1000, self.draw95thPercentile * 1000, self.presentMedian * 1000, self.present95thPercentile * 1000)
+        }
+    }
+
+    // MARK: - Properties
+
+    static let loggingEnvironmentKey:String = "ALWRITE_INK_LATENCY_LOG"
+    private static let signposter:OSSignposter = OSSignposter(subsystem: "com.trofimpetyanov.alwrite", category: "Ink")
+
+    /// Prints the summary as well as emitting it.
+    var isLoggingEnabled:Bool = ProcessInfo.processInfo.environment[InkLatencyMonitor.loggingEnvironmentKey] != nil
+    var reportInterval:Int = 240
+    /// Number of most recent samples kept for the summary.
+    let sampleCapacity:Int
+    private var pendingInputTimestamp:TimeInterval?
+    private var drawnInputTimestamps:[TimeInterval] = []
+    private var drawLatencies:[TimeInterval] = []
+    private var presentLatencies:[TimeInterval] = []
+    private var samplesSinceReport:Int = 0
+    private var displayLink:CADisplayLink?
+
+    init(sampleCapacity:Int = 1024) {
+        self.sampleCapacity = sampleCapacity
+        super.init()
+    }
+
+    deinit {
+        self.displayLink?.invalidate()
+    }
+
+    // MARK: - Events
+
+    func inputReceived(at timestamp:TimeInterval) {
+        if self.pendingInputTimestamp == nil {
+            self.pendingInputTimestamp = timestamp
+        }
+    }
+
+    func inkDrawn() {
+        guard let inputTimestamp = self.pendingInputTimestamp else { return }
+        self.pendingInputTimestamp = nil
+        self.append(ProcessInfo.processInfo.systemUptime - inputTimestamp, to: &self.drawLatencies)
+        self.drawnInputTimestamps.append(inputTimestamp)
+        self.waitForNextFrame()
+    }
+
+    // MARK: - Summary
+
+    func summary() -> Summary? {
+        guard !self.drawLatencies.isEmpty, !self.presentLatencies.isEmpty else { return nil }
+        let draw:[TimeInterval] = self.drawLatencies.sorted()
+        let present:[TimeInterval] = self.presentLatencies.sorted()
+        return Summary(sampleCount: present.count,
+                       drawMedian: draw[draw.count / 2],
+                       draw95thPercentile: draw[min(draw.count - 1, draw.count * 95 / 100)],
+                       presentMedian: present[present.count / 2],
+                       present95thPercentile: present[min(present.count - 1, present.count * 95 / 100)])
+    }
+
+    func reset() {
+        self.pendingInputTimestamp = nil
+        self.drawnInputTimestamps.removeAll()
+        self.drawLatencies.removeAll()
+        self.presentLatencies.removeAll()
+        self.samplesSinceReport = 0
+    }
+
+    // MARK: - Private Helpers
+
+    private func append(_ latency:TimeInterval, to samples:inout [TimeInterval]) {
+        if samples.count >= self.sampleCapacity {
+            samples.removeFirst(samples.count - self.sampleCapacity + 1)
+        }
+        samples.append(latency)
+    }
+
+    private func waitForNextFrame() {
+        if self.displayLink == nil {
+            let displayLink:CADisplayLink = CADisplayLink(target: DisplayLinkTarget(monitor: self), selector: #selector(DisplayLinkTarget.frameWillDisplay(_:)))
+            displayLink.add(to: .main, forMode: .common)
+            self.displayLink = displayLink
+        }
+        self.displayLink?.isPaused = false
+    }
+
+    fileprivate func frameWillDisplay(_ displayLink:CADisplayLink) {
+        displayLink.isPaused = true
+        for inputTimestamp in self.drawnInputTimestamps {
+            self.append(displayLink.targetTimestamp - inputTimestamp, to: &self.presentLatencies)
+        }
+        self.samplesSinceReport += self.drawnInputTimestamps.count
+        self.drawnInputTimestamps.removeAll()
+
+        if self.samplesSinceReport >= self.reportInterval, let summary = self.summary() {
+            self.samplesSinceReport = 0
+            self.report(summary)
+        }
+    }
+
+    private func report(_ summary:Summary) {
+        InkLatencyMonitor.signposter.emitEvent("InkLatency", "\(summary.description, privacy: .public)")
+        if self.isLoggingEnabled {
+            print(summary.description)
+        }
+    }
+}
+
+/// The display link retains its target; going through this object keeps the monitor free to be released.
+private class DisplayLinkTarget : NSObject {
+
+    weak var monitor:InkLatencyMonitor?
+
+    init(monitor:InkLatencyMonitor) {
+        self.monitor = monitor
+    }
+
+    @objc func frameWillDisplay(_ displayLink:CADisplayLink) {
+        guard let monitor = self.monitor else {
+            displayLink.invalidate()
+            return
+        }
+        monitor.frameWillDisplay(displayLink)
+    }
+}
@@ -13,8 +13,7 @@ extension NSAttributedString {
             let begin = text.getGlyphUtf16Begin(at: span.beginPosition, error: nil)
             let end = text.getGlyphUtf16End(at: span.endPosition - 1, error: nil)
             let range = NSMakeRange(Int(begin), Int(end - begin))
-            if let newFont = UIFont.fontFromStyle(style: span.style,
-                                                  string: text.label) {
+            if let newFont = FontStyleTable.shared.style(for: FontStyleKey(style: span.style)).font {
                 let dict: [Key:Any] = [.font : newFont,
                                        .ligature : NSNumber(value: 0)]
                 completeAttributedString.setAttributes(dict, range: range)
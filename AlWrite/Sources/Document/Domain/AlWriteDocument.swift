@@ -1,28 +1,162 @@
 import SwiftUI
 import PencilKit
 import Combine
+import InkCore
 
 class AlWriteDocument: UIDocument {
-    var blocks: [DrawingBlock] = [] {
+    var blocks = BlockList() {
         didSet {
-            if oldValue != blocks {
+            if !isReplacingLoadState, oldValue != blocks {
                 updateChangeCount(.done)
             }
         }
     }
 
+    /// Set while `blocks` changes only in what is held in memory, which is not an edit.
+    private var isReplacingLoadState = false
+
+    private struct CachedChunk {
+        /// Decoded strokes of `chunk`, `nil` until the block is faulted in or after it was released.
+        var drawing: PKDrawing?
+        let chunk: DocumentChunk
+        /// Block version last seen to match `chunk`; other versions fall back to comparing drawings.
+        var blockVersion: UInt64?
+
+        func matches(_ block: DrawingBlock, version: UInt64) -> Bool {
+            blockVersion == version || drawing == block.drawing
+        }
+    }
+
+    /// Chunks from the last save or load; a block whose drawing is unchanged reuses its chunk as is.
+    private var chunkCache: [UUID: CachedChunk] = [:]
+
+    // MARK: - Lazy Drawings
+
+    /// Takes blocks whose drawings were faulted in or released without marking the document as edited,
+    /// so scrolling or a memory warning does not trigger an autosave.
+    func replaceLoadState(with blocks: BlockList) {
+        isReplacingLoadState = true
+        defer { isReplacingLoadState = false }
+        self.blocks = blocks
+    }
+
+    func drawing(for id: UUID) throws -> PKDrawing {
+        guard let cached = chunkCache[id] else {
+            throw DocumentFormatError.missingChunk(blockId: id)
+        }
+        if let drawing = cached.drawing {
+            return drawing
+        }
+
+        let drawing = try PKDrawing(data: cached.chunk.validated(blockId: id))
+        chunkCache[id]?.drawing = drawing
+        return drawing
+    }
+
+    /// Drops the decoded strokes of a block whose chunk is up to date with it.
+    /// Returns `false` when the block has unsaved stroke changes and must stay in memory.
+    func releaseDrawing(of block: DrawingBlock, version: UInt64) -> Bool {
+        guard let cached = chunkCache[block.id], cached.matches(block, version: version) else {
+            return false
+        }
+        chunkCache[block.id]?.drawing = nil
+        chunkCache[block.id]?.blockVersion = nil
+        return true
+    }
+
+    // MARK: - Reading and Writing
+
     override func contents(forType typeName: String) throws -> Any {
-        let documentData = AlWriteDocumentData(
-            blocks: blocks
-        )
+        var records: [DocumentBlockRecord] = []
+        var updatedCache: [UUID: CachedChunk] = [:]
+        records.reserveCapacity(blocks.count)
+
+        for index in blocks.indices {
+            let block = blocks[index]
+            let version = blocks.version(at: index)
 
-        return try JSONEncoder().encode(documentData)
+            var entry: CachedChunk
+            if let cached = chunkCache[block.id], !block.isDrawingLoaded || cached.matches(block, version: version) {
+                entry = cached
+                if block.isDrawingLoaded {
+                    entry.blockVersion = version
+                }
+            } else {
+                entry = CachedChunk(
+                    drawing: block.drawing,
+                    chunk: DocumentChunk(data: block.drawing.dataRepresentation()),
+                    blockVersion: version
+                )
+            }
+            updatedCache[block.id] = entry
+
+            records.append(DocumentBlockRecord(
+                id: block.id,
+                typeCode: block.type.containerCode,
+                recognizedText: block.recognizedText,
+                isModified: block.isModified,
+                chunk: entry.chunk
+            ))
+        }
+
+        chunkCache = updatedCache
+        return DocumentContainer.encode(records)
     }
 
+    /// Only the block index is read here; stroke chunks are decoded on demand through `drawing(for:)`.
     override func load(fromContents contents: Any, ofType typeName: String?) throws {
         guard let data = contents as? Data else { return }
 
-        let documentData = try JSONDecoder().decode(AlWriteDocumentData.self, from: data)
-        blocks = documentData.blocks
+        guard DocumentContainer.isContainer(data) else {
+            let documentData = try JSONDecoder().decode(AlWriteDocumentData.self, from: data)
+            chunkCache.removeAll()
+            replaceLoadState(with: BlockList(documentData.blocks))
+            return
+        }
+
+        let records = try DocumentContainer.decode(data)
+        var loadedBlocks: [DrawingBlock] = []
+        var updatedCache: [UUID: CachedChunk] = [:]
+        loadedBlocks.reserveCapacity(records.count)
+
+        for record in records {
+            let type = try DrawingBlock.BlockType(containerCode: record.typeCode)
+            var entry = CachedChunk(drawing: nil, chunk: record.chunk, blockVersion: nil)
+            if let cached = chunkCache[record.id], cached.chunk.checksum == record.chunk.checksum,
+               cached.chunk.data.count == record.chunk.data.count {
+                entry.drawing = cached.drawing
+            }
+            updatedCache[record.id] = entry
+
+            loadedBlocks.append(DrawingBlock(
+                id: record.id,
+                type: type,
+                recognizedText: record.recognizedText,
+                isModified: record.isModified,
+                isDrawingLoaded: false
+            ))
+        }
+
+        chunkCache = updatedCache
+        replaceLoadState(with: BlockList(loadedBlocks))
+    }
+}
+
+// MARK: - Container Codes
+private extension DrawingBlock.BlockType {
+    /// Stored in the container index; existing codes must not change.
+    var containerCode: UInt8 {
+        switch self {
+        case .text: 0
+        case .math: 1
+        }
+    }
+
+    init(containerCode: UInt8) throws {
+        switch containerCode {
+        case 0: self = .text
+        case 1: self = .math
+        default: throw DocumentFormatError.invalidBlockType(containerCode)
+        }
     }
 }
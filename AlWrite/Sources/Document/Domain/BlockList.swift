@@ -0,0 +1,212 @@
+import Foundation
+
+/// Ordered blocks of a document with structural sharing and per-block versions.
+///
+/// Blocks live in fixed-size chunks shared between copies, so changing one block copies only its chunk and
+/// the chunk table instead of every block. Each change stamps the block with a version drawn from a counter
+/// shared by all copies of the list. Two lists are equal when they come from the same lineage and are at the
+/// same revision, which makes equality O(1) and lets consumers find changed blocks by version.
+///
+/// The list also keeps a short log of its latest changes, so a consumer holding an older revision of the
+/// same lineage can catch up in O(changes) through `changes(since:)`.
+struct BlockList {
+    /// Blocks changed between two revisions. Blocks are only ever appended, so `inserted` is in list order.
+    struct Changes {
+        var inserted: [UUID] = []
+        var removed: Set<UUID> = []
+        var updated: Set<UUID> = []
+
+        var isEmpty: Bool {
+            inserted.isEmpty && removed.isEmpty && updated.isEmpty
+        }
+    }
+
+    private enum Change {
+        case inserted(UUID)
+        case removed(UUID)
+        case updated(UUID)
+    }
+
+    private static let chunkSize = 32
+    private static let maxLoggedChanges = 256
+
+    private struct Entry {
+        var block: DrawingBlock
+        var version: UInt64
+    }
+
+    private final class Chunk {
+        var entries: [Entry]
+
+        init(entries: [Entry]) {
+            self.entries = entries
+        }
+    }
+
+    private final class Lineage {
+        private(set) var lastVersion: UInt64 = 0
+
+        func nextVersion() -> UInt64 {
+            lastVersion += 1
+            return lastVersion
+        }
+    }
+
+    private var chunks: [Chunk] = []
+    private var positions: [UUID: Int] = [:]
+    private var lineage = Lineage()
+    private var changeLog: [(version: UInt64, change: Change)] = []
+    /// Changes after this revision are all in `changeLog`.
+    private var changeLogFloor: UInt64 = 0
+
+    private(set) var count = 0
+    /// Version of the latest change to the list.
+    private(set) var revision: UInt64 = 0
+
+    init() { }
+
+    init<S: Sequence>(_ blocks: S) where S.Element == DrawingBlock {
+        let version = lineage.nextVersion()
+        rebuild(blocks.map { Entry(block: $0, version: version) })
+        revision = version
+        changeLogFloor = version
+    }
+
+    func index(of id: UUID) -> Int? {
+        positions[id]
+    }
+
+    subscript(id id: UUID) -> DrawingBlock? {
+        positions[id].map { self[$0] }
+    }
+
+    func version(at position: Int) -> UInt64 {
+        chunks[position / Self.chunkSize].entries[position % Self.chunkSize].version
+    }
+
+    func version(of id: UUID) -> UInt64? {
+        positions[id].map(version(at:))
+    }
+
+    func hasSameLineage(as other: BlockList) -> Bool {
+        lineage === other.lineage
+    }
+
+    /// Returns `nil` when `revision` is older than the change log, and the caller has to start over.
+    func changes(since revision: UInt64) -> Changes? {
+        guard revision >= changeLogFloor else { return nil }
+
+        var changes = Changes()
+        for (version, change) in changeLog where version > revision {
+            switch change {
+            case .inserted(let id):
+                changes.inserted.append(id)
+            case .removed(let id):
+                changes.updated.remove(id)
+                if let index = changes.inserted.firstIndex(of: id) {
+                    changes.inserted.remove(at: index)
+                } else {
+                    changes.removed.insert(id)
+                }
+            case .updated(let id):
+                if !changes.inserted.contains(id) {
+                    changes.updated.insert(id)
+                }
+            }
+        }
+        return changes
+    }
+
+    mutating func append(_ block: DrawingBlock) {
+        let version = stamp()
+        let entry = Entry(block: block, version: version)
+
+        if let last = chunks.indices.last, chunks[last].entries.count < Self.chunkSize {
+            makeChunkUnique(at: last)
+            chunks[last].entries.append(entry)
+        } else {
+            chunks.append(Chunk(entries: [entry]))
+        }
+        positions[block.id] = count
+        count += 1
+        log(.inserted(block.id), at: version)
+    }
+
+    @discardableResult
+    mutating func remove(id: UUID) -> DrawingBlock? {
+        guard let position = positions[id] else { return nil }
+
+        var entries = chunks.flatMap(\.entries)
+        let removed = entries.remove(at: position)
+        rebuild(entries)
+
+        log(.removed(id), at: stamp())
+        return removed.block
+    }
+
+    // MARK: - Private Helpers
+    private mutating func stamp() -> UInt64 {
+        let version = lineage.nextVersion()
+        revision = version
+        return version
+    }
+
+    private mutating func log(_ change: Change, at version: UInt64) {
+        changeLog.append((version, change))
+        if changeLog.count > Self.maxLoggedChanges {
+            let dropped = changeLog.count - Self.maxLoggedChanges / 2
+            changeLogFloor = changeLog[dropped - 1].version
+            changeLog.removeFirst(dropped)
+        }
+    }
+
+    private mutating func makeChunkUnique(at index: Int) {
+        if !isKnownUniquelyReferenced(&chunks[index]) {
+            chunks[index] = Chunk(entries: chunks[index].entries)
+        }
+    }
+
+    private mutating func rebuild(_ entries: [Entry]) {
+        chunks = stride(from: 0, to: entries.count, by: Self.chunkSize).map { start in
+            Chunk(entries: Array(entries[start..<min(start + Self.chunkSize, entries.count)]))
+        }
+        positions = Dictionary(entries.enumerated().map { ($1.block.id, $0) }, uniquingKeysWith: { first, _ in first })
+        count = entries.count
+    }
+}
+
+extension BlockList: RandomAccessCollection {
+    var startIndex: Int { 0 }
+    var endIndex: Int { count }
+
+    subscript(position: Int) -> DrawingBlock {
+        get {
+            chunks[position / Self.chunkSize].entries[position % Self.chunkSize].block
+        }
+        set {
+            let chunkIndex = position / Self.chunkSize
+            let entryIndex = position % Self.chunkSize
+            let oldId = chunks[chunkIndex].entries[entryIndex].block.id
+
+            let version = stamp()
+            makeChunkUnique(at: chunkIndex)
+            chunks[chunkIndex].entries[entryIndex] = Entry(block: newValue, version: version)
+
+            if newValue.id == oldId {
+                log(.updated(oldId), at: version)
+            } else {
+                // Replacing a block by another one is not expressible as an append, so consumers start over.
+                positions[oldId] = nil
+                positions[newValue.id] = position
+                changeLog.removeAll()
+                changeLogFloor = version
+            }
+        }
+    }
+}
+
+extension BlockList: Equatable {
+    static func == (lhs: BlockList, rhs: BlockList) -> Bool {
+        lhs.lineage === rhs.lineage && lhs.revision == rhs.revision
+    }
+}
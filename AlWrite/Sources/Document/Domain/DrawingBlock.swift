@@ -12,19 +12,31 @@ struct DrawingBlock: Identifiable, Codable {
     var type: BlockType
     var recognizedText: String?
     var isModified: Bool
+    /// `false` while the strokes are still only in the document's chunk store and `drawing` is a placeholder.
+    var isDrawingLoaded: Bool = true
+
+    private enum CodingKeys: String, CodingKey {
+        case id
+        case drawing
+        case type
+        case recognizedText
+        case isModified
+    }
 
     init(
         id: UUID = UUID(),
         drawing: PKDrawing = PKDrawing(),
         type: BlockType,
         recognizedText: String? = nil,
-        isModified: Bool = true
+        isModified: Bool = true,
+        isDrawingLoaded: Bool = true
     ) {
         self.id = id
         self.drawing = drawing
         self.type = type
         self.recognizedText = recognizedText
         self.isModified = isModified
+        self.isDrawingLoaded = isDrawingLoaded
     }
 } 
 
@@ -1,4 +1,5 @@
 import Foundation
+import InkCore
 import PencilKit
 import Combine
 
@@ -29,23 +30,29 @@ struct DocumentState: Equatable {
     }
 
     var document: AlWriteDocument?
-    var blocks: [DrawingBlock] = []
+    var blocks = BlockList()
     var isViewerVisible: Bool = false
     var isToolPickerVisible: Bool = false
     var viewerPosition: ViewerPosition = .right
     var viewerProportion: ViewerProportionState = .half
 
     var isRecognitionLoading: Bool = false
-    var combinedRecognizedText: String = ""
+    /// Intermediate results of blocks still being recognized, shown until their final text arrives.
+    var partialRecognizedTexts: [UUID: String] = [:]
+    var recognizedOutput = RecognizedOutput()
 }
 
 enum DocumentEvent {
     case setDocument(AlWriteDocument)
-    case documentLoaded(blocks: [DrawingBlock])
+    case documentLoaded(blocks: BlockList)
     
     case addBlock(type: DrawingBlock.BlockType)
     case deleteRequested(id: UUID)
     case updateBlockDrawing(id: UUID, drawing: PKDrawing)
+
+    case blockDrawingsNeeded(ids: [UUID])
+    case visibleBlocksChanged(ids: Set<UUID>)
+    case memoryWarningReceived
     
     case recognitionProcessNeeded
     case recognitionCompleted(Result<String, Error>)
@@ -1,6 +1,8 @@
 import Foundation
+import InkCore
 import Combine
 import PencilKit
+import UIKit
 
 @MainActor
 final class DocumentStore: Store {
@@ -10,27 +12,33 @@ final class DocumentStore: Store {
     private let router: DocumentRouting
     private let dependenciesContainer: DocumentDependenciesContainer
     private let recognitionManager: HandwritingRecognizer
+    private let recognitionScheduler: RecognitionScheduler<RecognitionJob>
+    private let recognitionDebouncer = RecognitionDebouncer()
     private weak var document: AlWriteDocument?
-    private var recognitionTask: Task<Void, Never>?
+    private var visibleBlockIds: Set<UUID> = []
+    private var editingBlockId: UUID?
+    private let latencyTracker = RecognitionLatencyTracker()
 
-    private let drawingDidChangeSubject = PassthroughSubject<Void, Never>()
-    private var drawingChangeSubscription: AnyCancellable?
-
-    private typealias BlockRecognitionResult = (id: UUID, result: Result<String, Error>)
+    private var memoryWarningSubscription: AnyCancellable?
 
     init(router: DocumentRouting, dependenciesContainer: DocumentDependenciesContainer, document: AlWriteDocument?) {
         self.state = DocumentState()
         self.router = router
         self.dependenciesContainer = dependenciesContainer
         self.recognitionManager = dependenciesContainer.recognitionManager
+        self.recognitionScheduler = RecognitionScheduler(
+            maxConcurrentJobs: dependenciesContainer.recognitionManager.maxConcurrentJobs
+        ) { [recognizer = dependenciesContainer.recognitionManager] job in
+            try await recognizer.recognize(job)
+        }
         self.document = document
 
-        setupDrawingDebouncer()
+        setupRecognition()
+        setupMemoryWarningObserver()
     }
 
     deinit {
-        recognitionTask?.cancel()
-        drawingChangeSubscription?.cancel()
+        memoryWarningSubscription?.cancel()
     }
 
     func handle(_ event: DocumentEvent) {
@@ -41,83 +49,68 @@ final class DocumentStore: Store {
         case .documentLoaded(let blocks):
             state.blocks = blocks
             self.document?.blocks = blocks
+            resetRecognizedOutput()
             handle(.recognitionProcessNeeded)
 
         case .addBlock(let type):
             let newBlock = DrawingBlock(type: type)
             state.blocks.append(newBlock)
+            resetRecognizedOutput()
             document?.blocks = state.blocks
             document?.updateChangeCount(.done)
             handle(.recognitionProcessNeeded)
 
         case .updateBlockDrawing(let id, let drawing):
-            if let index = state.blocks.firstIndex(where: { $0.id == id }) {
-                state.blocks[index].drawing = drawing
-                state.blocks[index].isModified = true
+            if let index = state.blocks.index(of: id), state.blocks[index].isDrawingLoaded {
+                var block = state.blocks[index]
+                block.drawing = drawing
+                block.isModified = true
+                state.blocks[index] = block
+                if editingBlockId != id {
+                    editingBlockId = id
+                    recognitionScheduler.updatePriorities(recognitionPriority(for:))
+                }
                 document?.blocks = state.blocks
                 document?.updateChangeCount(.done)
-                drawingDidChangeSubject.send()
+                recognitionScheduler.discardPending(blockId: id)
+                recognitionDebouncer.blockDidChange(id)
+                latencyTracker.penUp(in: id)
+                recognitionManager.streamPartialResults(of: recognitionJob(for: block)) { [weak self] text in
+                    self?.applyPartialResult(text, blockId: id)
+                }
             }
 
         case .deleteRequested(let id):
-            state.blocks.removeAll { $0.id == id }
+            state.blocks.remove(id: id)
+            recognitionDebouncer.cancel(id)
+            recognitionScheduler.cancel(blockId: id)
+            recognitionManager.forgetBlock(id)
+            latencyTracker.cancel(for: id)
+            state.partialRecognizedTexts[id] = nil
+            resetRecognizedOutput()
+            if editingBlockId == id {
+                editingBlockId = nil
+            }
             document?.blocks = state.blocks
             document?.updateChangeCount(.done)
             handle(.recognitionProcessNeeded)
 
+        case .blockDrawingsNeeded(let ids):
+            loadDrawings(for: ids)
+
+        case .visibleBlocksChanged(let ids):
+            visibleBlockIds = ids
+            loadDrawings(for: ids)
+            recognitionScheduler.updatePriorities(recognitionPriority(for:))
+
+        case .memoryWarningReceived:
+            releaseHiddenDrawings()
+
         case .recognitionProcessNeeded:
-            recognitionTask?.cancel()
-
-            recognitionTask = Task { [weak self] in
-                guard let self = self else { return }
-                
-                await MainActor.run { self.state.isRecognitionLoading = true }
-                
-                let blocksToProcess = self.state.blocks
-                var results: [BlockRecognitionResult] = []
-                
-                do {
-                    try await withThrowingTaskGroup(of: BlockRecognitionResult.self) { group in
-                        for block in blocksToProcess {
-                            if block.isModified || block.recognizedText == nil {
-                                let blockId = block.id
-                                let blockType = block.type
-                                
-                                group.addTask { [weak self] in
-                                    guard let self = self else {
-                                        throw CancellationError()
-                                    }
-                                    
-                                    guard let currentBlock = await self.state.blocks.first(where: { $0.id == blockId }) else {
-                                        return (id: blockId, result: .failure(CancellationError()))
-                                    }
-                                    let drawingToProcess = currentBlock.drawing
-                                    
-                                    let mode: StandardRecognitionMode = (blockType == .math) ? .math : .text
-                                    await self.recognitionManager.setRecognitionMode(mode)
-                                    
-                                    do {
-                                        let recognizedText = try await self.recognitionManager.processDrawing(drawingToProcess)
-                                        return (id: blockId, result: .success(recognizedText))
-                                    } catch {
-                                        return (id: blockId, result: .failure(error))
-                                    }
-                                }
-                            }
-                        }
-                        for try await result in group {
-                            results.append(result)
-                        }
-                    }
-                    await self.updateStateWithRecognitionResults(processedResults: results)
-
-                } catch {
-                    if !(error is CancellationError) {
-                        print("Recognition TaskGroup Error: \(error)")
-                    }
-                    await MainActor.run { self.state.isRecognitionLoading = false }
-                }
-            }
+            // Strokes are faulted in by `makeRecognitionJob` once a job starts, not for every stale block here.
+            state.blocks
+                .filter { $0.isModified || $0.recognizedText == nil }
+                .forEach { scheduleRecognition(for: $0.id) }
 
         case .changeViewerPosition(let position):
             state.viewerPosition = position
@@ -138,56 +131,169 @@ final class DocumentStore: Store {
     }
     
     // MARK: - Private Helpers
-    private func updateStateWithRecognitionResults(processedResults: [BlockRecognitionResult]) {
-        let resultMap = Dictionary(uniqueKeysWithValues: processedResults.map { ($0.id, $0.result) })
+    private func scheduleRecognition(for id: UUID) {
+        guard state.blocks.index(of: id) != nil else { return }
 
-        var finalBlocks: [DrawingBlock] = []
-        var combinedTextParts: [String] = []
+        recognitionScheduler.schedule(blockId: id, priority: recognitionPriority(for: id))
+        state.isRecognitionLoading = true
+    }
 
-        for index in state.blocks.indices {
-            var block = state.blocks[index]
-            
-            if let result = resultMap[block.id] {
-                switch result {
-                case .success(let text):
-                    block.recognizedText = text
-                    block.isModified = false
-                case .failure(let error):
-                    if let recognitionError = error as? RecognitionError, recognitionError == .noStrokesToRecognize {
-                        block.recognizedText = ""
-                    } else {
-                        block.recognizedText = block.recognizedText ?? "[Recognition Error]"
-                    }
-                    block.isModified = false
-                    if !(error is RecognitionError && (error as! RecognitionError) == .noStrokesToRecognize) {
-                         print("Recognition failed for block \(block.id): \(error.localizedDescription)")
-                    }
-                }
-                state.blocks[index] = block
-            }
-            
-            if let recognizedText = state.blocks[index].recognizedText, !recognizedText.isEmpty {
-                let textToAppend = state.blocks[index].type == .math ? "$$\(recognizedText)$$" : recognizedText
-                combinedTextParts.append(textToAppend)
-            } else if state.blocks[index].type == .text {
-                combinedTextParts.append("")
+    /// Called by the scheduler as the job starts, so only blocks actually being recognized are loaded.
+    private func makeRecognitionJob(for id: UUID) -> RecognitionJob? {
+        loadDrawings(for: [id])
+        guard let block = state.blocks[id: id], block.isDrawingLoaded else {
+            state.isRecognitionLoading = !recognitionScheduler.isIdle
+            return nil
+        }
+        return recognitionJob(for: block)
+    }
+
+    private func recognitionJob(for block: DrawingBlock) -> RecognitionJob {
+        let mode: StandardRecognitionMode = (block.type == .math) ? .math : .text
+        return RecognitionJob(
+            blockId: block.id,
+            blockVersion: state.blocks.version(of: block.id) ?? 0,
+            mode: mode,
+            drawing: block.drawing
+        )
+    }
+
+    private func recognitionPriority(for id: UUID) -> RecognitionPriority {
+        if id == editingBlockId {
+            return .editing
+        }
+        return visibleBlockIds.contains(id) ? .visible : .offscreen
+    }
+
+    private func applyRecognitionResult(_ result: Result<String, Error>, of job: RecognitionJob) {
+        guard let index = state.blocks.index(of: job.blockId) else {
+            state.isRecognitionLoading = !recognitionScheduler.isIdle
+            return
+        }
+
+        var block = state.blocks[index]
+        switch result {
+        case .success(let text):
+            block.recognizedText = text
+        case .failure(let error):
+            if let recognitionError = error as? RecognitionError, recognitionError == .noStrokesToRecognize {
+                block.recognizedText = ""
+            } else {
+                block.recognizedText = block.recognizedText ?? "[Recognition Error]"
+                print("Recognition failed for block \(block.id): \(error.localizedDescription)")
             }
         }
+        // Strokes added while the job ran still need their own pass. Drawings are only compared when the
+        // block changed in some other way since the job was created.
+        if state.blocks.version(at: index) == job.blockVersion || block.drawing == job.drawing {
+            block.isModified = false
+            state.partialRecognizedTexts[block.id] = nil
+        }
+        state.blocks[index] = block
+
+        updateRecognizedOutput(for: block)
+        latencyTracker.textShown(in: block.id)
+        state.isRecognitionLoading = !recognitionScheduler.isIdle
 
-        state.combinedRecognizedText = combinedTextParts.joined(separator: "\n\n")
-        
-        state.isRecognitionLoading = false
-        
         document?.blocks = state.blocks
         document?.updateChangeCount(.done)
     }
 
-    private func setupDrawingDebouncer() {
-        drawingChangeSubscription = drawingDidChangeSubject
-            .debounce(for: .seconds(1.0), scheduler: DispatchQueue.global())
+    private func applyPartialResult(_ text: String, blockId: UUID) {
+        guard let block = state.blocks[id: blockId], block.isModified else { return }
+
+        state.partialRecognizedTexts[blockId] = text
+        updateRecognizedOutput(for: block)
+        if !text.isEmpty {
+            latencyTracker.textShown(in: blockId)
+        }
+    }
+
+    private func resetRecognizedOutput() {
+        state.recognizedOutput.reset(state.blocks.map { block in
+            RecognizedOutput.Segment(blockId: block.id, text: outputText(for: block))
+        })
+    }
+
+    private func updateRecognizedOutput(for block: DrawingBlock) {
+        state.recognizedOutput.setText(outputText(for: block), for: block.id)
+    }
+
+    /// Math blocks without text are left out of the output, empty text blocks still separate paragraphs.
+    private func outputText(for block: DrawingBlock) -> String? {
+        let displayedText = state.partialRecognizedTexts[block.id] ?? block.recognizedText
+        if let recognizedText = displayedText, !recognizedText.isEmpty {
+            return block.type == .math ? "$$\(recognizedText)$$" : recognizedText
+        }
+        return block.type == .text ? "" : nil
+    }
+
+    private func loadDrawings(for ids: some Sequence<UUID>) {
+        guard let document else { return }
+
+        var blocks = state.blocks
+        var didLoad = false
+        for id in ids {
+            guard let index = blocks.index(of: id), !blocks[index].isDrawingLoaded else {
+                continue
+            }
+            do {
+                var block = blocks[index]
+                block.drawing = try document.drawing(for: id)
+                block.isDrawingLoaded = true
+                blocks[index] = block
+                didLoad = true
+            } catch {
+                print("Failed to load drawing for block \(id): \(error)")
+            }
+        }
+
+        guard didLoad else { return }
+        state.blocks = blocks
+        document.replaceLoadState(with: blocks)
+    }
+
+    private func releaseHiddenDrawings() {
+        guard let document else { return }
+
+        var blocks = state.blocks
+        var didRelease = false
+        for index in blocks.indices {
+            let block = blocks[index]
+            guard block.isDrawingLoaded, !block.isModified, !visibleBlockIds.contains(block.id),
+                  document.releaseDrawing(of: block, version: blocks.version(at: index)) else {
+                continue
+            }
+            var releasedBlock = block
+            releasedBlock.drawing = PKDrawing()
+            releasedBlock.isDrawingLoaded = false
+            blocks[index] = releasedBlock
+            didRelease = true
+        }
+
+        guard didRelease else { return }
+        state.blocks = blocks
+        document.replaceLoadState(with: blocks)
+    }
+
+    private func setupMemoryWarningObserver() {
+        memoryWarningSubscription = NotificationCenter.default
+            .publisher(for: UIApplication.didReceiveMemoryWarningNotification)
             .receive(on: DispatchQueue.main)
             .sink { [weak self] _ in
-                self?.handle(.recognitionProcessNeeded)
+                self?.handle(.memoryWarningReceived)
             }
     }
+
+    private func setupRecognition() {
+        recognitionScheduler.onResult = { [weak self] job, result in
+            self?.applyRecognitionResult(result, of: job)
+        }
+        recognitionScheduler.makeJob = { [weak self] id in
+            self?.makeRecognitionJob(for: id)
+        }
+        recognitionDebouncer.onFire = { [weak self] id in
+            self?.scheduleRecognition(for: id)
+        }
+    }
 }
\ No newline at end of file
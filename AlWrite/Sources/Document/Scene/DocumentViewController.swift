@@ -81,24 +81,34 @@ class DocumentViewController: UIDocumentViewController {
     // MARK: - Bindings
 
     private func bindToViewStore() {
-        viewStore.$state
+        viewStore.scope(\.blocks).publisher
+            .map(\.isEmpty)
             .removeDuplicates()
-            .sink { [weak self] state in
-                self?.update(for: state)
+            .sink { [weak self] isEmpty in
+                self?.toolPickerItem?.isEnabled = !isEmpty
+            }
+            .store(in: &observations)
+
+        viewStore.scope(\.isToolPickerVisible).publisher
+            .sink { [weak self] isVisible in
+                self?.updateToolPickerButton(isVisible: isVisible)
             }
             .store(in: &observations)
-    }
 
-    private func update(for state: DocumentState) {
-        toolPickerItem?.isEnabled = !state.blocks.isEmpty
+        viewStore.scope(\.isViewerVisible).publisher
+            .sink { [weak self] isVisible in
+                self?.update(viewerVisible: isVisible)
+            }
+            .store(in: &observations)
+    }
 
-        updateToolPickerButton(isVisible: state.isToolPickerVisible)
-        updateViewerButton(isVisible: state.isViewerVisible)
+    private func update(viewerVisible isVisible: Bool) {
+        updateViewerButton(isVisible: isVisible)
 
         if let viewerVC = viewerViewController,
            viewerVC.view.superview != nil,
-           viewerVC.view.isHidden != !state.isViewerVisible {
-            updateViewerVisibility(isVisible: state.isViewerVisible)
+           viewerVC.view.isHidden != !isVisible {
+            updateViewerVisibility(isVisible: isVisible)
         }
     }
     
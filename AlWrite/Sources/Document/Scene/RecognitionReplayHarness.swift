@@ -0,0 +1,231 @@
+import Combine
+import Foundation
+import PencilKit
+
+enum RecognitionReplayError: Error, Equatable {
+    case openFailed(URL)
+    case timedOut
+}
+
+/// Replays the strokes of a recorded notebook through `DocumentStore` against `FakeRecognitionEngine`
+/// and reports how soon recognized text followed each pen-up.
+///
+/// Needs no UI and no MyScript assets: `AlWriteBenchmarks.testRecognitionReplay` runs it on the `.alwrite`
+/// file that `ALWRITE_REPLAY_NOTEBOOK` points to and prints the report once every block is recognized.
+@MainActor
+final class RecognitionReplayHarness {
+    static let notebookEnvironmentKey = "ALWRITE_REPLAY_NOTEBOOK"
+
+    struct Report {
+        let blockCount: Int
+        let strokeCount: Int
+        let duration: TimeInterval
+        let recognitionCount: Int
+        let partialResultCount: Int
+        let finalTextLatencies: [TimeInterval]
+        let partialTextLatencies: [TimeInterval]
+
+        var summary: String {
+            """
+            Replayed \(strokeCount) strokes in \(blockCount) blocks over \(format(seconds: duration))
+            Recognitions: \(recognitionCount), partial results: \(partialResultCount)
+            Pen-up to final text: \(percentiles(of: finalTextLatencies))
+            Pen-up to partial text: \(percentiles(of: partialTextLatencies))
+            """
+        }
+
+        /// Nearest-rank percentile, `nil` without samples.
+        static func percentile(_ percentile: Double, of samples: [TimeInterval]) -> TimeInterval? {
+            guard !samples.isEmpty else { return nil }
+            let sorted = samples.sorted()
+            let rank = Int((percentile / 100 * Double(sorted.count)).rounded(.up))
+            return sorted[min(max(rank, 1), sorted.count) - 1]
+        }
+
+        private func percentiles(of samples: [TimeInterval]) -> String {
+            guard !samples.isEmpty else { return "no samples" }
+            return [50.0, 95.0, 99.0]
+                .compactMap { p in Self.percentile(p, of: samples).map { "p\(Int(p)) \(Int($0 * 1000)) ms" } }
+                .joined(separator: ", ") + " (\(samples.count) samples)"
+        }
+
+        private func format(seconds: TimeInterval) -> String {
+            String(format: "%.1f s", seconds)
+        }
+    }
+
+    private struct StrokeEvent {
+        let blockId: UUID
+        let drawing: PKDrawing
+        let time: TimeInterval
+    }
+
+    /// Pairs pen-ups with the state changes that answer them.
+    private final class LatencyRecorder {
+        private(set) var finalTextLatencies: [TimeInterval] = []
+        private(set) var partialTextLatencies: [TimeInterval] = []
+        private var pendingFinal: [UUID: TimeInterval] = [:]
+        private var pendingPartial: [UUID: TimeInterval] = [:]
+        private var shownPartials: [UUID: String] = [:]
+
+        func penUp(in blockId: UUID) {
+            let now = ProcessInfo.processInfo.systemUptime
+            if pendingFinal[blockId] == nil {
+                pendingFinal[blockId] = now
+            }
+            if pendingPartial[blockId] == nil {
+                pendingPartial[blockId] = now
+            }
+        }
+
+        func observe(_ state: DocumentState) {
+            let now = ProcessInfo.processInfo.systemUptime
+            for (blockId, penUp) in pendingPartial {
+                guard let text = state.partialRecognizedTexts[blockId], !text.isEmpty,
+                      text != shownPartials[blockId] else { continue }
+                shownPartials[blockId] = text
+                partialTextLatencies.append(now - penUp)
+                pendingPartial[blockId] = nil
+            }
+            for (blockId, penUp) in pendingFinal {
+                guard let block = state.blocks[id: blockId], !block.isModified else { continue }
+                finalTextLatencies.append(now - penUp)
+                pendingFinal[blockId] = nil
+                pendingPartial[blockId] = nil
+                shownPartials[blockId] = nil
+            }
+        }
+    }
+
+    /// Values above 1 replay faster than the strokes were written.
+    var speed: Double = 1
+    /// Longer pauses in the recording, such as between writing sessions, are shortened to this.
+    var maxIdleGap: TimeInterval = 2
+    var timeout: TimeInterval = 60
+    var engineConfiguration = FakeRecognitionEngine.Configuration()
+    var poolSize = RecognitionWorkerPool.defaultSize
+
+    func replay(notebookAt url: URL) async throws -> Report {
+        try await replay(Self.recordedBlocks(ofNotebookAt: url))
+    }
+
+    /// Every block of the notebook with its strokes loaded.
+    static func recordedBlocks(ofNotebookAt url: URL) async throws -> [DrawingBlock] {
+        let document = AlWriteDocument(fileURL: url)
+        guard await document.open() else {
+            throw RecognitionReplayError.openFailed(url)
+        }
+
+        var blocks: [DrawingBlock] = []
+        do {
+            for block in document.blocks {
+                var recorded = block
+                if !block.isDrawingLoaded {
+                    recorded.drawing = try document.drawing(for: block.id)
+                    recorded.isDrawingLoaded = true
+                }
+                blocks.append(recorded)
+            }
+        } catch {
+            _ = await document.close()
+            throw error
+        }
+        _ = await document.close()
+
+        return blocks
+    }
+
+    /// Starts from empty blocks and writes the strokes of `recordedBlocks` into them one at a time.
+    func replay(_ recordedBlocks: [DrawingBlock]) async throws -> Report {
+        let fileManager = FileManager.default
+        let cacheDirectory = fileManager.temporaryDirectory
+            .appendingPathComponent("ReplayResults-\(UUID().uuidString)", isDirectory: true)
+        defer { try? fileManager.removeItem(at: cacheDirectory) }
+
+        let engine = FakeRecognitionEngine(configuration: engineConfiguration)
+        let recognitionManager = HandwritingRecognitionManager(
+            engine: engine,
+            poolSize: poolSize,
+            resultCache: RecognitionResultCache(directory: cacheDirectory)
+        )
+        let store = DocumentStore(
+            router: HeadlessDocumentRouter(),
+            dependenciesContainer: DocumentDependenciesContainer(recognitionManager: recognitionManager),
+            document: nil
+        )
+
+        let recorder = LatencyRecorder()
+        let subscription = store.statePublisher.sink { state in
+            recorder.observe(state)
+        }
+        defer { subscription.cancel() }
+
+        let emptyBlocks = recordedBlocks.map { block in
+            DrawingBlock(id: block.id, type: block.type, recognizedText: "", isModified: false)
+        }
+        store.handle(.documentLoaded(blocks: BlockList(emptyBlocks)))
+        store.handle(.visibleBlocksChanged(ids: Set(emptyBlocks.map(\.id))))
+
+        let events = strokeEvents(of: recordedBlocks)
+        let start = ProcessInfo.processInfo.systemUptime
+        for event in events {
+            try await sleep(until: start + event.time / speed)
+            recorder.penUp(in: event.blockId)
+            store.handle(.updateBlockDrawing(id: event.blockId, drawing: event.drawing))
+        }
+
+        let deadline = ProcessInfo.processInfo.systemUptime + timeout
+        while store.state.isRecognitionLoading || store.state.blocks.contains(where: \.isModified) {
+            guard ProcessInfo.processInfo.systemUptime < deadline else {
+                throw RecognitionReplayError.timedOut
+            }
+            try await Task.sleep(nanoseconds: 10_000_000)
+        }
+
+        return Report(
+            blockCount: recordedBlocks.count,
+            strokeCount: events.count,
+            duration: ProcessInfo.processInfo.systemUptime - start,
+            recognitionCount: engine.statistics.processedDrawings,
+            partialResultCount: engine.statistics.partialResults,
+            finalTextLatencies: recorder.finalTextLatencies,
+            partialTextLatencies: recorder.partialTextLatencies
+        )
+    }
+
+    // MARK: - Private Helpers
+    /// One event per stroke at its pen-up, carrying the block's drawing up to and including that stroke.
+    private func strokeEvents(of blocks: [DrawingBlock]) -> [StrokeEvent] {
+        var timedEvents: [(penUp: Date, blockId: UUID, drawing: PKDrawing)] = []
+        for block in blocks {
+            let strokes = block.drawing.strokes
+            for index in strokes.indices {
+                let path = strokes[index].path
+                let penUp = path.creationDate.addingTimeInterval(path.last?.timeOffset ?? 0)
+                timedEvents.append((penUp, block.id, PKDrawing(strokes: Array(strokes[...index]))))
+            }
+        }
+        timedEvents.sort { $0.penUp < $1.penUp }
+
+        var events: [StrokeEvent] = []
+        events.reserveCapacity(timedEvents.count)
+        var time: TimeInterval = 0
+        var previousPenUp = timedEvents.first?.penUp
+        for timed in timedEvents {
+            time += min(max(timed.penUp.timeIntervalSince(previousPenUp ?? timed.penUp), 0), maxIdleGap)
+            previousPenUp = timed.penUp
+            events.append(StrokeEvent(blockId: timed.blockId, drawing: timed.drawing, time: time))
+        }
+        return events
+    }
+
+    private func sleep(until uptime: TimeInterval) async throws {
+        let delay = uptime - ProcessInfo.processInfo.systemUptime
+        guard delay > 0 else { return }
+        try await Task.sleep(nanoseconds: UInt64(delay * 1_000_000_000))
+    }
+}
+
+private final class HeadlessDocumentRouter: DocumentRouting {
+    func showDocumentViewController() {}
+}
@@ -0,0 +1,132 @@
+import Combine
+import PencilKit
+import UIKit
+
+/// Bitmaps of block drawings for blocks shown without a live canvas.
+///
+/// A block keeps at most one bitmap, stamped with the block version and pixel width it was rendered for.
+/// Bitmaps are rendered off the main thread, and the least recently used ones are dropped once their
+/// total size grows past `byteBudget`.
+@MainActor
+final class BlockThumbnailCache {
+    struct Key: Hashable {
+        let blockId: UUID
+        let version: UInt64
+        let pixelWidth: Int
+        let userInterfaceStyle: UIUserInterfaceStyle
+    }
+
+    private struct Entry {
+        let key: Key
+        let image: UIImage
+        let byteCount: Int
+    }
+
+    private struct PendingRender {
+        let key: Key
+        var completions: [(UIImage) -> Void]
+    }
+
+    let byteBudget: Int
+    private(set) var totalBytes = 0
+    private var entries: [UUID: Entry] = [:]
+    private var usageOrder: [UUID] = []
+    private var pendingRenders: [UUID: PendingRender] = [:]
+    private let renderQueue = DispatchQueue(label: "com.trofimpetyanov.alwrite.block-thumbnails", qos: .userInitiated)
+    private var memoryWarningSubscription: AnyCancellable?
+
+    init(byteBudget: Int = 32 * 1024 * 1024) {
+        self.byteBudget = byteBudget
+        memoryWarningSubscription = NotificationCenter.default
+            .publisher(for: UIApplication.didReceiveMemoryWarningNotification)
+            .receive(on: DispatchQueue.main)
+            .sink { [weak self] _ in
+                self?.removeAll()
+            }
+    }
+
+    func thumbnail(for key: Key) -> UIImage? {
+        guard let entry = entries[key.blockId], entry.key == key else { return nil }
+        markUsed(key.blockId)
+        return entry.image
+    }
+
+    /// The latest bitmap of a block whatever it was rendered for, to show until an up to date one is ready.
+    func placeholder(for blockId: UUID) -> UIImage? {
+        entries[blockId]?.image
+    }
+
+    /// Renders `pageRect` of `drawing` with the appearance of `traits`.
+    /// A newer request for the same block supersedes this one, and `completion` is then never called.
+    func render(
+        _ drawing: PKDrawing,
+        for key: Key,
+        pageRect: CGRect,
+        traits: UITraitCollection,
+        completion: @escaping (UIImage) -> Void
+    ) {
+        if pendingRenders[key.blockId]?.key == key {
+            pendingRenders[key.blockId]?.completions.append(completion)
+            return
+        }
+        pendingRenders[key.blockId] = PendingRender(key: key, completions: [completion])
+
+        let scale = CGFloat(key.pixelWidth) / max(pageRect.width, 1)
+        renderQueue.async { [weak self] in
+            var image = UIImage()
+            traits.performAsCurrent {
+                image = drawing.image(from: pageRect, scale: scale)
+            }
+            DispatchQueue.main.async {
+                self?.finishRender(image, for: key)
+            }
+        }
+    }
+
+    func remove(_ blockId: UUID) {
+        pendingRenders[blockId] = nil
+        guard let entry = entries.removeValue(forKey: blockId) else { return }
+        totalBytes -= entry.byteCount
+        usageOrder.removeAll { $0 == blockId }
+    }
+
+    func removeAll() {
+        entries.removeAll()
+        usageOrder.removeAll()
+        pendingRenders.removeAll()
+        totalBytes = 0
+    }
+
+    // MARK: - Private Helpers
+    private func finishRender(_ image: UIImage, for key: Key) {
+        guard let pending = pendingRenders[key.blockId], pending.key == key else { return }
+        pendingRenders[key.blockId] = nil
+
+        let pixelSize = CGSize(width: image.size.width * image.scale, height: image.size.height * image.scale)
+        let byteCount = Int(pixelSize.width) * Int(pixelSize.height) * 4
+        if let previous = entries[key.blockId] {
+            totalBytes -= previous.byteCount
+        }
+        entries[key.blockId] = Entry(key: key, image: image, byteCount: byteCount)
+        totalBytes += byteCount
+        markUsed(key.blockId)
+        evictIfNeeded()
+
+        pending.completions.forEach { $0(image) }
+    }
+
+    private func markUsed(_ blockId: UUID) {
+        usageOrder.removeAll { $0 == blockId }
+        usageOrder.append(blockId)
+    }
+
+    /// The most recent bitmap is always kept, even when it alone is over budget.
+    private func evictIfNeeded() {
+        while totalBytes > byteBudget, usageOrder.count > 1 {
+            let blockId = usageOrder.removeFirst()
+            if let entry = entries.removeValue(forKey: blockId) {
+                totalBytes -= entry.byteCount
+            }
+        }
+    }
+}
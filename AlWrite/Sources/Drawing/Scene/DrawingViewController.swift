@@ -5,8 +5,8 @@ import UIKit
 class DrawingViewController: UIViewController {
 
     // MARK: - Type Aliases
-    private typealias DataSource = UICollectionViewDiffableDataSource<Section, DrawingBlock>
-    private typealias Snapshot = NSDiffableDataSourceSnapshot<Section, DrawingBlock>
+    private typealias DataSource = UICollectionViewDiffableDataSource<Section, UUID>
+    private typealias Snapshot = NSDiffableDataSourceSnapshot<Section, UUID>
 
     // MARK: - Section Enum
     private enum Section {
@@ -18,6 +18,13 @@ class DrawingViewController: UIViewController {
     let toolPicker: PKToolPicker
     private var observations: Set<AnyCancellable> = []
     private weak var activeCanvasView: PKCanvasView?
+    private var displayedBlockIds: Set<UUID> = []
+    /// Blocks the current snapshot was built from; newer lists are applied as changes since its revision.
+    private var snapshotBlocks: BlockList?
+    /// Only the focused block gets a live canvas; the others are drawn from `thumbnailCache`.
+    private var focusedBlockId: UUID?
+    private let canvasPool = CanvasPool(capacity: 4)
+    private let thumbnailCache = BlockThumbnailCache()
 
     private var theView: DrawingCanvasView { view as! DrawingCanvasView }
     private var dataSource: DataSource!
@@ -41,6 +48,7 @@ class DrawingViewController: UIViewController {
         super.viewDidLoad()
         configureDataSource()
         theView.collectionView.delegate = self
+        theView.collectionView.prefetchDataSource = self
         bind(to: viewStore)
     }
 
@@ -52,33 +60,40 @@ class DrawingViewController: UIViewController {
 
     // MARK: - Configuration (DataSource setup remains in VC)
     private func configureDataSource() {
-        let cellRegistration = UICollectionView.CellRegistration<CanvasBlockCell, DrawingBlock> { [weak self] (cell, indexPath, block) in
-            guard let self = self else { return }
+        let cellRegistration = UICollectionView.CellRegistration<CanvasBlockCell, UUID> { [weak self] (cell, indexPath, blockId) in
+            guard let self = self, let block = self.viewStore.state.blocks[id: blockId] else { return }
 
-            cell.configure(with: block)
+            let version = self.viewStore.state.blocks.version(of: blockId) ?? 0
+            if blockId == self.focusedBlockId {
+                let canvas = self.canvasPool.canvas(for: blockId)
+                let isDrawingCurrent = self.canvasPool.isCurrent(blockId, version: version, drawing: block.drawing)
+                cell.configure(with: block, canvas: canvas, isDrawingCurrent: isDrawingCurrent)
+                if !isDrawingCurrent {
+                    self.canvasPool.markCurrent(blockId, version: version)
+                }
+                self.toolPicker.addObserver(canvas)
+            } else {
+                cell.configure(with: block, version: version, thumbnails: self.thumbnailCache)
+            }
 
             cell.drawingDidChange = { [weak self] newDrawing in
-                self?.viewStore.handle(.updateBlockDrawing(id: block.id, drawing: newDrawing))
+                guard let self = self else { return }
+                self.viewStore.handle(.updateBlockDrawing(id: blockId, drawing: newDrawing))
+                // The stroke came from this canvas, so it already shows the block's new version.
+                self.canvasPool.markCurrent(blockId, version: self.viewStore.state.blocks.version(of: blockId))
             }
-            cell.didTapCell = { [weak self, weak cell] in
-                guard let self = self, let tappedCell = cell else { return }
-                let newActiveCanvas = tappedCell.canvasView
-                tappedCell.makeCanvasFirstResponder()
-                self.activeCanvasView = newActiveCanvas
+            cell.didTapCell = { [weak self] in
+                self?.focusBlock(blockId)
             }
-
-            self.toolPicker.addObserver(cell.canvasView)
         }
 
         dataSource = DataSource(
             collectionView: theView.collectionView
-        ) { (collectionView, indexPath, block) -> UICollectionViewCell? in
-            return collectionView.dequeueConfiguredReusableCell(using: cellRegistration, for: indexPath, item: block)
+        ) { (collectionView, indexPath, blockId) -> UICollectionViewCell? in
+            return collectionView.dequeueConfiguredReusableCell(using: cellRegistration, for: indexPath, item: blockId)
         }
 
-        viewStore.$state
-            .map(\.isToolPickerVisible)
-            .removeDuplicates()
+        viewStore.scope(\.isToolPickerVisible).publisher
             .dropFirst()
             .sink { [weak self] isVisible in
                 guard let self = self else { return }
@@ -88,9 +103,11 @@ class DrawingViewController: UIViewController {
                     }
                 } else {
                     if self.activeCanvasView == nil {
-                        if let firstVisibleCell = self.theView.collectionView.visibleCells.first as? CanvasBlockCell {
-                            firstVisibleCell.makeCanvasFirstResponder()
-                            self.activeCanvasView = firstVisibleCell.canvasView
+                        let collectionView = self.theView.collectionView
+                        if let firstVisibleCell = collectionView.visibleCells.first,
+                           let indexPath = collectionView.indexPath(for: firstVisibleCell),
+                           let blockId = self.dataSource.itemIdentifier(for: indexPath) {
+                            self.focusBlock(blockId)
                         }
                     }
                     if let activeCanvas = self.activeCanvasView {
@@ -107,22 +124,71 @@ class DrawingViewController: UIViewController {
     private func bind(
         to viewStore: ViewStore<DocumentState, DocumentEvent>
     ) {
-        viewStore.$state
-            .map(\.blocks)
-            .removeDuplicates()
+        // Applying a snapshot from inside a display callback is not allowed, and loading drawings for newly
+        // displayed blocks changes the list from there.
+        viewStore.scope(\.blocks).publisher
+            .receive(on: DispatchQueue.main)
             .sink { [weak self] blocks in
                 self?.applySnapshot(blocks: blocks)
             }
             .store(in: &observations)
     }
 
-    private func applySnapshot(blocks: [DrawingBlock]) {
-        var snapshot = Snapshot()
-        snapshot.appendSections([.main])
-        snapshot.appendItems(blocks)
-        dataSource.apply(snapshot, animatingDifferences: true)
+    private func applySnapshot(blocks: BlockList) {
+        defer {
+            snapshotBlocks = blocks
+            updateEmptyState(isEmpty: blocks.isEmpty)
+        }
+
+        guard let previousBlocks = snapshotBlocks, previousBlocks.hasSameLineage(as: blocks),
+              let changes = blocks.changes(since: previousBlocks.revision) else {
+            if snapshotBlocks.map({ !$0.hasSameLineage(as: blocks) }) ?? false {
+                canvasPool.invalidateVersions()
+                thumbnailCache.removeAll()
+            }
+            if let focusedBlockId, blocks.index(of: focusedBlockId) == nil {
+                self.focusedBlockId = nil
+            }
+            var snapshot = Snapshot()
+            snapshot.appendSections([.main])
+            snapshot.appendItems(blocks.map(\.id))
+            dataSource.apply(snapshot, animatingDifferences: true)
+            return
+        }
+        guard !changes.isEmpty else { return }
+
+        changes.removed.forEach(canvasPool.remove)
+        changes.removed.forEach(thumbnailCache.remove)
+        if let focusedBlockId, changes.removed.contains(focusedBlockId) {
+            self.focusedBlockId = nil
+        }
+
+        var snapshot = dataSource.snapshot()
+        snapshot.deleteItems(Array(changes.removed))
+        snapshot.appendItems(changes.inserted)
+        snapshot.reconfigureItems(Array(changes.updated))
+        dataSource.apply(snapshot, animatingDifferences: !changes.inserted.isEmpty || !changes.removed.isEmpty)
+    }
+
+    // MARK: - Focus
+    /// Moves the live canvas to `blockId`, turning the previously focused block back into a bitmap.
+    private func focusBlock(_ blockId: UUID) {
+        if blockId != focusedBlockId {
+            var snapshot = dataSource.snapshot()
+            let reconfiguredIds = [focusedBlockId, blockId].compactMap { $0 }.filter { snapshot.indexOfItem($0) != nil }
+            focusedBlockId = blockId
+            snapshot.reconfigureItems(reconfiguredIds)
+            dataSource.apply(snapshot, animatingDifferences: false)
+        }
 
-        updateEmptyState(isEmpty: blocks.isEmpty)
+        guard let indexPath = dataSource.indexPath(for: blockId),
+              let cell = theView.collectionView.cell(forItemAt: indexPath) as? CanvasBlockCell,
+              let canvas = cell.canvasView else { return }
+        cell.makeCanvasFirstResponder()
+        activeCanvasView = canvas
+        if viewStore.state.isToolPickerVisible {
+            toolPicker.setVisible(true, forFirstResponder: canvas)
+        }
     }
 
     // MARK: - Empty State Handling
@@ -168,18 +234,40 @@ class DrawingViewController: UIViewController {
 // MARK: - UICollectionViewDelegate
 extension DrawingViewController: UICollectionViewDelegate {
 
+    func collectionView(_ collectionView: UICollectionView, willDisplay cell: UICollectionViewCell, forItemAt indexPath: IndexPath) {
+        guard let blockId = dataSource.itemIdentifier(for: indexPath) else { return }
+        displayedBlockIds.insert(blockId)
+        viewStore.handle(.visibleBlocksChanged(ids: displayedBlockIds))
+    }
+
+    func collectionView(_ collectionView: UICollectionView, didEndDisplaying cell: UICollectionViewCell, forItemAt indexPath: IndexPath) {
+        guard let blockId = dataSource.itemIdentifier(for: indexPath) else { return }
+        displayedBlockIds.remove(blockId)
+        viewStore.handle(.visibleBlocksChanged(ids: displayedBlockIds))
+    }
+
     // Context Menu for Deletion
     func collectionView(_ collectionView: UICollectionView, contextMenuConfigurationForItemAt indexPath: IndexPath, point: CGPoint) -> UIContextMenuConfiguration? {
         
-        guard let block = dataSource.itemIdentifier(for: indexPath) else {
+        guard let blockId = dataSource.itemIdentifier(for: indexPath) else {
             return nil
         }
 
         return UIContextMenuConfiguration(identifier: indexPath as NSIndexPath, previewProvider: nil) { suggestedActions in
             let deleteAction = UIAction(title: "Удалить", image: UIImage(systemName: "trash"), attributes: .destructive) { [weak self] action in
-                 self?.viewStore.handle(.deleteRequested(id: block.id))
+                 self?.viewStore.handle(.deleteRequested(id: blockId))
             }
             return UIMenu(title: "", children: [deleteAction])
         }
     }
 }
+
+// MARK: - UICollectionViewDataSourcePrefetching
+extension DrawingViewController: UICollectionViewDataSourcePrefetching {
+
+    func collectionView(_ collectionView: UICollectionView, prefetchItemsAt indexPaths: [IndexPath]) {
+        let ids = indexPaths.compactMap { dataSource.itemIdentifier(for: $0) }
+        guard !ids.isEmpty else { return }
+        viewStore.handle(.blockDrawingsNeeded(ids: ids))
+    }
+}
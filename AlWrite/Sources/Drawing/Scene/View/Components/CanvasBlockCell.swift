@@ -10,18 +10,24 @@ class CanvasBlockCell: UICollectionViewCell {
 
     private let standardPageWidth: CGFloat = 595.2
     private let desiredAspectRatio: CGFloat = 0.25
+    private var isApplyingBlockDrawing = false
 
-    lazy var canvasView: PKCanvasView = {
-        let canvas = PKCanvasView()
-        canvas.translatesAutoresizingMaskIntoConstraints = false
-        canvas.delegate = self
-        canvas.backgroundColor = .clear
-        canvas.isOpaque = false
-        canvas.isScrollEnabled = false
-        canvas.minimumZoomScale = 0.1
-        canvas.maximumZoomScale = 4.0
-        canvas.zoomScale = 1.0
-        return canvas
+    private struct ThumbnailSource {
+        let block: DrawingBlock
+        let version: UInt64
+        let cache: BlockThumbnailCache
+    }
+
+    /// Borrowed from the `CanvasPool` while the cell shows the focused block, and handed back in `prepareForReuse`.
+    private(set) var canvasView: PKCanvasView?
+    private var thumbnailSource: ThumbnailSource?
+    private var displayedThumbnailKey: BlockThumbnailCache.Key?
+
+    private lazy var thumbnailView: UIImageView = {
+        let imageView = UIImageView()
+        imageView.translatesAutoresizingMaskIntoConstraints = false
+        imageView.contentMode = .scaleToFill
+        return imageView
     }()
 
     override init(frame: CGRect) {
@@ -36,40 +42,65 @@ class CanvasBlockCell: UICollectionViewCell {
     override func layoutSubviews() {
         super.layoutSubviews()
         updateZoomScale()
+        updateThumbnail()
     }
 
     private func setupViews() {
-        contentView.addSubview(canvasView)
-        NSLayoutConstraint.activate([
-            canvasView.topAnchor.constraint(equalTo: contentView.topAnchor),
-            canvasView.leadingAnchor.constraint(equalTo: contentView.leadingAnchor),
-            canvasView.trailingAnchor.constraint(equalTo: contentView.trailingAnchor),
-            canvasView.bottomAnchor.constraint(equalTo: contentView.bottomAnchor)
-        ])
         contentView.backgroundColor = .systemBackground
         contentView.layer.cornerRadius = 10
         contentView.layer.masksToBounds = true
         
         let tapGesture = UITapGestureRecognizer(target: self, action: #selector(handleTap))
         contentView.addGestureRecognizer(tapGesture)
+
+        contentView.addSubview(thumbnailView)
+        NSLayoutConstraint.activate([
+            thumbnailView.topAnchor.constraint(equalTo: contentView.topAnchor),
+            thumbnailView.leadingAnchor.constraint(equalTo: contentView.leadingAnchor),
+            thumbnailView.trailingAnchor.constraint(equalTo: contentView.trailingAnchor),
+            thumbnailView.bottomAnchor.constraint(equalTo: contentView.bottomAnchor)
+        ])
+
+        registerForTraitChanges([UITraitUserInterfaceStyle.self, UITraitDisplayScale.self]) { (cell: CanvasBlockCell, _) in
+            cell.updateThumbnail()
+        }
     }
 
-    func configure(with block: DrawingBlock) {
-        if canvasView.drawing != block.drawing {
-            canvasView.drawing = block.drawing
+    /// Shows `block` on `canvas`. The drawing is only assigned when the canvas does not show it already.
+    func configure(with block: DrawingBlock, canvas: PKCanvasView, isDrawingCurrent: Bool) {
+        clearThumbnail()
+        attach(canvas)
+        if !isDrawingCurrent {
+            isApplyingBlockDrawing = true
+            canvas.drawing = block.drawing
+            isApplyingBlockDrawing = false
         }
+        canvas.isUserInteractionEnabled = block.isDrawingLoaded
         updateZoomScale()
     }
 
+    /// Shows `block` as a bitmap from `thumbnails`, rendering one when there is none for `version` yet.
+    func configure(with block: DrawingBlock, version: UInt64, thumbnails: BlockThumbnailCache) {
+        detachCanvas()
+        if thumbnailSource?.block.id != block.id {
+            clearThumbnail()
+        }
+        thumbnailSource = ThumbnailSource(block: block, version: version, cache: thumbnails)
+        thumbnailView.isHidden = false
+        updateThumbnail()
+    }
+
     func makeCanvasFirstResponder() {
-        canvasView.becomeFirstResponder()
+        canvasView?.becomeFirstResponder()
     }
 
+    /// The canvas keeps its strokes, so the block does not have to be drawn again when it comes back.
     override func prepareForReuse() {
         super.prepareForReuse()
         drawingDidChange = nil
         didTapCell = nil
-        canvasView.drawing = PKDrawing()
+        detachCanvas()
+        clearThumbnail()
     }
 
     // MARK: - Self Sizing
@@ -82,8 +113,76 @@ class CanvasBlockCell: UICollectionViewCell {
     }
 
     // MARK: - Private Helpers
+    private func attach(_ canvas: PKCanvasView) {
+        canvas.delegate = self
+        guard canvas !== canvasView || canvas.superview !== contentView else { return }
+
+        canvasView?.removeFromSuperview()
+        canvas.removeFromSuperview()
+        contentView.addSubview(canvas)
+        NSLayoutConstraint.activate([
+            canvas.topAnchor.constraint(equalTo: contentView.topAnchor),
+            canvas.leadingAnchor.constraint(equalTo: contentView.leadingAnchor),
+            canvas.trailingAnchor.constraint(equalTo: contentView.trailingAnchor),
+            canvas.bottomAnchor.constraint(equalTo: contentView.bottomAnchor)
+        ])
+        canvasView = canvas
+    }
+
+    private func detachCanvas() {
+        guard let canvasView else { return }
+        if canvasView.superview === contentView {
+            canvasView.removeFromSuperview()
+        }
+        if canvasView.delegate === self {
+            canvasView.delegate = nil
+        }
+        self.canvasView = nil
+    }
+
+    private func clearThumbnail() {
+        thumbnailSource = nil
+        displayedThumbnailKey = nil
+        thumbnailView.image = nil
+        thumbnailView.isHidden = true
+    }
+
+    private func updateThumbnail() {
+        guard let source = thumbnailSource, bounds.width > 0 else { return }
+
+        let key = BlockThumbnailCache.Key(
+            blockId: source.block.id,
+            version: source.version,
+            pixelWidth: Int((bounds.width * traitCollection.displayScale).rounded()),
+            userInterfaceStyle: traitCollection.userInterfaceStyle
+        )
+        guard key != displayedThumbnailKey else { return }
+
+        if let image = source.cache.thumbnail(for: key) {
+            showThumbnail(image, for: key)
+            return
+        }
+        if let placeholder = source.cache.placeholder(for: key.blockId) {
+            thumbnailView.image = placeholder
+        }
+        // Drawings not faulted in yet are rendered once loading them reconfigures the cell.
+        guard source.block.isDrawingLoaded else { return }
+
+        let pageRect = CGRect(x: 0, y: 0, width: standardPageWidth, height: standardPageWidth * desiredAspectRatio)
+        source.cache.render(source.block.drawing, for: key, pageRect: pageRect, traits: traitCollection) { [weak self] image in
+            guard let self, let current = self.thumbnailSource,
+                  current.block.id == key.blockId, current.version == key.version else { return }
+            self.showThumbnail(image, for: key)
+        }
+    }
+
+    private func showThumbnail(_ image: UIImage, for key: BlockThumbnailCache.Key) {
+        thumbnailView.image = image
+        displayedThumbnailKey = key
+    }
+
     private func updateZoomScale() {
-        guard bounds.width > 0, standardPageWidth > 0 else { return }
+        guard let canvasView, bounds.width > 0, standardPageWidth > 0 else { return }
         let scale = bounds.width / standardPageWidth
         guard scale > 0, scale.isFinite else { return }
 
@@ -108,6 +207,7 @@ class CanvasBlockCell: UICollectionViewCell {
 
 extension CanvasBlockCell: PKCanvasViewDelegate {
     func canvasViewDrawingDidChange(_ canvasView: PKCanvasView) {
+        guard !isApplyingBlockDrawing else { return }
         drawingDidChange?(canvasView.drawing)
     }
 }
@@ -0,0 +1,90 @@
+import UIKit
+import PencilKit
+
+/// Keeps recently used canvases bound to their blocks, so a block scrolled back into view gets its canvas
+/// with the strokes already in place.
+///
+/// Each canvas remembers the block version its drawing was taken from. A canvas at the block's current
+/// version is used as is; any other version falls back to comparing drawings before one is assigned.
+@MainActor
+final class CanvasPool {
+    private struct Entry {
+        let canvas: PKCanvasView
+        var version: UInt64?
+    }
+
+    private let capacity: Int
+    private var entries: [UUID: Entry] = [:]
+    private var usageOrder: [UUID] = []
+
+    init(capacity: Int = 16) {
+        self.capacity = capacity
+    }
+
+    func canvas(for blockId: UUID) -> PKCanvasView {
+        defer { markUsed(blockId) }
+        if let entry = entries[blockId] {
+            return entry.canvas
+        }
+
+        let canvas = evictIfNeeded() ?? Self.makeCanvas()
+        entries[blockId] = Entry(canvas: canvas, version: nil)
+        return canvas
+    }
+
+    /// Whether the block's canvas already shows `drawing`; records `version` when it does.
+    func isCurrent(_ blockId: UUID, version: UInt64, drawing: PKDrawing) -> Bool {
+        guard let entry = entries[blockId] else { return false }
+        if entry.version == version {
+            return true
+        }
+        guard entry.canvas.drawing == drawing else { return false }
+        entries[blockId]?.version = version
+        return true
+    }
+
+    func markCurrent(_ blockId: UUID, version: UInt64?) {
+        entries[blockId]?.version = version
+    }
+
+    /// Versions of another block list mean nothing here; drawings are compared again on next use.
+    func invalidateVersions() {
+        for blockId in entries.keys {
+            entries[blockId]?.version = nil
+        }
+    }
+
+    func remove(_ blockId: UUID) {
+        entries[blockId]?.canvas.removeFromSuperview()
+        entries[blockId] = nil
+        usageOrder.removeAll { $0 == blockId }
+    }
+
+    // MARK: - Private Helpers
+    private func markUsed(_ blockId: UUID) {
+        usageOrder.removeAll { $0 == blockId }
+        usageOrder.append(blockId)
+    }
+
+    /// Frees the least recently used canvas that is not on screen and returns it for reuse.
+    private func evictIfNeeded() -> PKCanvasView? {
+        guard entries.count >= capacity,
+              let index = usageOrder.firstIndex(where: { entries[$0].map { $0.canvas.superview == nil } ?? false }) else {
+            return nil
+        }
+        let blockId = usageOrder.remove(at: index)
+        return entries.removeValue(forKey: blockId)?.canvas
+    }
+
+    private static func makeCanvas() -> PKCanvasView {
+        let canvas = PKCanvasView()
+        canvas.translatesAutoresizingMaskIntoConstraints = false
+        canvas.backgroundColor = .clear
+        canvas.isOpaque = false
+        canvas.isScrollEnabled = false
+        canvas.minimumZoomScale = 0.1
+        canvas.maximumZoomScale = 4.0
+        canvas.zoomScale = 1.0
+        return canvas
+    }
+}
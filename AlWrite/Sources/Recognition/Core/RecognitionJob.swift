@@ -0,0 +1,15 @@
+import Foundation
+import InkCore
+import PencilKit
+
+/// A single recognition request. The mode travels with the job, so blocks of different types can be
+/// recognized at the same time without sharing any mode state.
+struct RecognitionJob: SchedulableRecognitionJob {
+    let blockId: UUID
+    /// Version of the block the drawing was taken from, used to tell whether the result is still current.
+    let blockVersion: UInt64
+    let mode: StandardRecognitionMode
+    let drawing: PKDrawing
+    /// Set by the scheduler when the job starts; orders jobs waiting for a worker.
+    var priority: RecognitionPriority = .visible
+}
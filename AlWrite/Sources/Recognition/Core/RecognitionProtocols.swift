@@ -30,13 +30,29 @@ protocol RecognitionMode {
     var description: String { get }
 }
 
-protocol RecognitionService {
-    func processDrawing(_ drawing: PKDrawing) async throws -> String
-    func clear()
+enum RecognitionSessionLimits {
+    /// How many of the most recently processed blocks a session keeps the strokes of.
+    static let heldBlocks = 6
+}
+
+/// Recognizes the drawings of several blocks, one call at a time. A session may keep the strokes of the
+/// blocks it recently processed, so the next call for one of them only has to send what changed.
+protocol RecognitionSession {
+    func process(_ drawing: PKDrawing, blockId: UUID) async throws -> String
+    /// Drops whatever the session keeps for a deleted block.
+    func forgetBlock(_ blockId: UUID) async
+}
+
+/// Reports intermediate results while strokes are still being recognized.
+protocol StreamingRecognitionSession: AnyObject {
+    var onPartialResult: ((String) -> Void)? { get set }
+    func update(_ drawing: PKDrawing)
 }
 
 protocol RecognitionEngine {
-    var currentMode: RecognitionMode { get }
-    func setMode(_ mode: RecognitionMode)
-    func createRecognizer() -> RecognitionService
+    var language: String { get }
+    /// Identifies the engine and asset revision; results produced under another one are not reused.
+    var assetVersion: String { get }
+    func createSession(mode: RecognitionMode) throws -> RecognitionSession
+    func createStreamingSession(mode: RecognitionMode) throws -> StreamingRecognitionSession
 }
@@ -0,0 +1,26 @@
+import Foundation
+import InkCore
+import PencilKit
+
+/// Hash of a drawing's ink geometry. Timestamps, ink and force are left out, so undo/redo and copies of a
+/// block hash the same as the original.
+struct StrokeContentHash: Hashable {
+    let value: UInt64
+
+    /// Walks the PencilKit paths in place rather than converting them to an `InkDrawing` first.
+    init(_ drawing: PKDrawing) {
+        var hasher = InkContentHasher()
+        for stroke in drawing.strokes {
+            hasher.beginStroke(pointCount: stroke.path.count)
+            for point in stroke.path {
+                let location = point.location.applying(stroke.transform)
+                hasher.combinePoint(x: Double(location.x), y: Double(location.y))
+            }
+        }
+        value = hasher.value
+    }
+
+    var hexString: String {
+        String(format: "%016llx", value)
+    }
+}
@@ -0,0 +1,21 @@
+import Foundation
+import PencilKit
+
+/// Cheap identity of a stroke, used to match strokes already fed to a recognition session.
+struct StrokeFingerprint: Hashable {
+    let creationTime: TimeInterval
+    let pointCount: Int
+    let start: SIMD2<Float>
+    let end: SIMD2<Float>
+    let transform: [CGFloat]
+
+    init(_ stroke: PKStroke) {
+        let path = stroke.path
+        creationTime = path.creationDate.timeIntervalSinceReferenceDate
+        pointCount = path.count
+        start = path.first.map { SIMD2(Float($0.location.x), Float($0.location.y)) } ?? .zero
+        end = path.last.map { SIMD2(Float($0.location.x), Float($0.location.y)) } ?? .zero
+        let t = stroke.transform
+        transform = [t.a, t.b, t.c, t.d, t.tx, t.ty]
+    }
+}
@@ -1,14 +1,23 @@
 import Foundation
 
 final class RecognitionEngineFactory {
-    
+    /// Set in the scheme's environment to run the app without the MyScript SDK.
+    static let fakeEngineEnvironmentKey = "ALWRITE_FAKE_RECOGNITION"
+
     init() {}
     
-    func createMyScriptEngine() -> RecognitionEngine {
-        MyScriptRecognitionEngine()
+    func createMyScriptEngine() throws -> RecognitionEngine {
+        try MyScriptRecognitionEngine()
+    }
+
+    func createFakeEngine(configuration: FakeRecognitionEngine.Configuration = .init()) -> RecognitionEngine {
+        FakeRecognitionEngine(configuration: configuration)
     }
     
-    func createDefaultEngine() -> RecognitionEngine {
-        createMyScriptEngine()
+    func createDefaultEngine() throws -> RecognitionEngine {
+        if ProcessInfo.processInfo.environment[Self.fakeEngineEnvironmentKey] != nil {
+            return createFakeEngine()
+        }
+        return try createMyScriptEngine()
     }
 }
@@ -4,10 +4,24 @@ import MyScriptInteractiveInk_Runtime
 final class EngineProvider {
 
     static var sharedInstance = EngineProvider()
+    static let recognitionLanguage = "ru_RU"
+    /// Versions of the bundled recognition assets; bump when `recognition-assets` is updated.
+    static let recognitionAssetsVersion = "text-4.0.0;math-4.0.0"
+    /// Resolved configuration directory per app bundle location, so later launches skip probing the bundle.
+    private static let configurationPathDefaultsKey = "EngineProvider.configurationPaths"
+
     var engineErrorMessage: String = ""
     static var isEngineInitialized = false
 
-    lazy var engine: IINKEngine? = {
+    /// Creating the engine validates the certificate and probes the bundle, so it usually happens on the
+    /// recognition bootstrap queue; other threads asking meanwhile wait for that engine instead of making another.
+    var engine: IINKEngine? {
+        lock.withLock { loadedEngine }
+    }
+
+    private let lock = NSLock()
+
+    private lazy var loadedEngine: IINKEngine? = {
         if myCertificate.length == 0 {
             self.engineErrorMessage =
                 "Please replace the content of MyCertificate.c with the certificate you received from the developer portal"
@@ -20,40 +34,9 @@ final class EngineProvider {
             return nil
         }
 
-        let bundleResourcePath = Bundle.main.resourcePath ?? Bundle.main.bundlePath
         let fileManager = FileManager.default
+        let configurationPath = Self.configurationPath()
 
-        let possiblePaths = [
-            bundleResourcePath + "/Resources/recognition-assets/conf",
-            bundleResourcePath + "/recognition-assets/conf",
-            Bundle.main.bundlePath + "/recognition-assets/conf"
-        ]
-        
-        var configurationPath = ""
-
-        for path in possiblePaths {
-            if fileManager.fileExists(atPath: path) {
-                configurationPath = path
-                break
-            }
-        }
-
-        if configurationPath.isEmpty {
-            do {
-                let bundleContents = try fileManager.contentsOfDirectory(atPath: Bundle.main.bundlePath)
-
-                if bundleContents.contains("recognition-assets") {
-                    configurationPath = Bundle.main.bundlePath + "/recognition-assets/conf"
-                }
-            } catch {
-                print("Failed to search bundle: \(error.localizedDescription)")
-            }
-
-            if configurationPath.isEmpty {
-                configurationPath = Bundle.main.bundlePath + "/recognition-assets/conf"
-            }
-        }
-        
         do {
             if !configurationPath.isEmpty && !fileManager.fileExists(atPath: configurationPath) {
                 try fileManager.createDirectory(atPath: configurationPath, withIntermediateDirectories: true)
@@ -84,7 +67,7 @@ final class EngineProvider {
         try? engine.configuration.set(number: 5, forKey: "renderer.drop-shadow.radius")
 
         // Set recognition language to Russian
-        try? engine.configuration.set(string: "ru_RU", forKey: "text.language")
+        try? engine.configuration.set(string: EngineProvider.recognitionLanguage, forKey: "text.language")
 
         EngineProvider.isEngineInitialized = true
         return engine
@@ -99,4 +82,48 @@ final class EngineProvider {
     }
 
     private init() { }
+
+    // MARK: - Private Helpers
+    private static func configurationPath() -> String {
+        let bundlePath = Bundle.main.bundlePath
+        let defaults = UserDefaults.standard
+        let cachedPaths = defaults.dictionary(forKey: configurationPathDefaultsKey) as? [String: String] ?? [:]
+        if let cachedPath = cachedPaths[bundlePath], FileManager.default.fileExists(atPath: cachedPath) {
+            return cachedPath
+        }
+
+        let configurationPath = probeConfigurationPath()
+        if FileManager.default.fileExists(atPath: configurationPath) {
+            // Reinstalls move the bundle, so entries for older locations are dropped.
+            defaults.set([bundlePath: configurationPath], forKey: configurationPathDefaultsKey)
+        }
+        return configurationPath
+    }
+
+    private static func probeConfigurationPath() -> String {
+        let bundleResourcePath = Bundle.main.resourcePath ?? Bundle.main.bundlePath
+        let fileManager = FileManager.default
+
+        let possiblePaths = [
+            bundleResourcePath + "/Resources/recognition-assets/conf",
+            bundleResourcePath + "/recognition-assets/conf",
+            Bundle.main.bundlePath + "/recognition-assets/conf"
+        ]
+
+        for path in possiblePaths where fileManager.fileExists(atPath: path) {
+            return path
+        }
+
+        do {
+            let bundleContents = try fileManager.contentsOfDirectory(atPath: Bundle.main.bundlePath)
+
+            if bundleContents.contains("recognition-assets") {
+                return Bundle.main.bundlePath + "/recognition-assets/conf"
+            }
+        } catch {
+            print("Failed to search bundle: \(error.localizedDescription)")
+        }
+
+        return Bundle.main.bundlePath + "/recognition-assets/conf"
+    }
 }
@@ -0,0 +1,127 @@
+import Foundation
+import PencilKit
+
+/// Stand-in for the MyScript engine that needs neither a certificate nor recognition assets.
+///
+/// Results and latencies are derived from the drawing's content hash, so the same strokes always produce
+/// the same text after the same delay. Used to measure the recognition pipeline on its own.
+final class FakeRecognitionEngine: RecognitionEngine {
+    struct Configuration {
+        var baseLatency: TimeInterval = 0.08
+        var latencyPerStroke: TimeInterval = 0.004
+        /// Upper bound of the extra delay picked from the content hash.
+        var jitter: TimeInterval = 0.04
+        var partialResultLatency: TimeInterval = 0.02
+    }
+
+    /// Work done by all sessions of the engine, to tell recognitions apart from cache hits.
+    final class Statistics {
+        private let lock = NSLock()
+        private var processed = 0
+        private var partials = 0
+
+        var processedDrawings: Int {
+            lock.withLock { processed }
+        }
+
+        var partialResults: Int {
+            lock.withLock { partials }
+        }
+
+        fileprivate func recordProcessedDrawing() {
+            lock.withLock { processed += 1 }
+        }
+
+        fileprivate func recordPartialResult() {
+            lock.withLock { partials += 1 }
+        }
+    }
+
+    let configuration: Configuration
+    let statistics = Statistics()
+    let language = EngineProvider.recognitionLanguage
+    /// Kept apart from real engine versions, so fake results never satisfy a real lookup in the result cache.
+    let assetVersion = "fake-engine-1"
+
+    init(configuration: Configuration = Configuration()) {
+        self.configuration = configuration
+    }
+
+    func createSession(mode: RecognitionMode) throws -> RecognitionSession {
+        FakeRecognitionSession(engine: self, mode: mode)
+    }
+
+    func createStreamingSession(mode: RecognitionMode) throws -> StreamingRecognitionSession {
+        FakeStreamingSession(engine: self, mode: mode)
+    }
+
+    fileprivate func transcript(of drawing: PKDrawing, hash: StrokeContentHash, mode: RecognitionMode) -> String {
+        let strokeCount = drawing.strokes.count
+        if mode.mimeTypeString == StandardRecognitionMode.math.mimeTypeString {
+            return "x_{\(strokeCount)} + \(hash.value % 100)"
+        }
+        return "ink \(strokeCount) \(hash.hexString.prefix(6))"
+    }
+
+    fileprivate func latency(of drawing: PKDrawing, hash: StrokeContentHash) -> TimeInterval {
+        let fraction = Double(hash.value % 1_000) / 1_000
+        return configuration.baseLatency
+            + configuration.latencyPerStroke * Double(drawing.strokes.count)
+            + configuration.jitter * fraction
+    }
+}
+
+private final class FakeRecognitionSession: RecognitionSession {
+    private let engine: FakeRecognitionEngine
+    private let mode: RecognitionMode
+
+    init(engine: FakeRecognitionEngine, mode: RecognitionMode) {
+        self.engine = engine
+        self.mode = mode
+    }
+
+    func process(_ drawing: PKDrawing, blockId: UUID) async throws -> String {
+        if drawing.strokes.isEmpty {
+            throw RecognitionError.noStrokesToRecognize
+        }
+
+        let hash = StrokeContentHash(drawing)
+        try await Task.sleep(nanoseconds: UInt64(engine.latency(of: drawing, hash: hash) * 1_000_000_000))
+        engine.statistics.recordProcessedDrawing()
+        return engine.transcript(of: drawing, hash: hash, mode: mode)
+    }
+
+    func forgetBlock(_ blockId: UUID) {}
+}
+
+private final class FakeStreamingSession: StreamingRecognitionSession {
+    var onPartialResult: ((String) -> Void)?
+
+    private let engine: FakeRecognitionEngine
+    private let mode: RecognitionMode
+    private var pendingResult: DispatchWorkItem?
+
+    init(engine: FakeRecognitionEngine, mode: RecognitionMode) {
+        self.engine = engine
+        self.mode = mode
+    }
+
+    deinit {
+        pendingResult?.cancel()
+    }
+
+    /// Like the real recognizer, a newer drawing replaces a result that has not been reported yet.
+    func update(_ drawing: PKDrawing) {
+        pendingResult?.cancel()
+        guard !drawing.strokes.isEmpty else { return }
+
+        let text = engine.transcript(of: drawing, hash: StrokeContentHash(drawing), mode: mode)
+        let workItem = DispatchWorkItem { [weak self] in
+            guard let self else { return }
+            self.engine.statistics.recordPartialResult()
+            self.onPartialResult?(text)
+        }
+        pendingResult = workItem
+        DispatchQueue.main.asyncAfter(deadline: .now() + engine.configuration.partialResultLatency, execute: workItem)
+    }
+}
@@ -3,35 +3,29 @@ import MyScriptInteractiveInk_Runtime
 import PencilKit
 
 final class MyScriptRecognitionEngine: RecognitionEngine {
-    private(set) var currentMode: RecognitionMode = StandardRecognitionMode.text
     private let engine: IINKEngine
-    private var serviceCache: [String: RecognitionService] = [:]
+
+    var language: String {
+        EngineProvider.recognitionLanguage
+    }
+
+    var assetVersion: String {
+        "\(engine.version);\(EngineProvider.recognitionAssetsVersion)"
+    }
     
-    init() {
+    init() throws {
         guard let engine = EngineProvider.sharedInstance.engine else {
-            fatalError("Failed to initialize IINKEngine: \(EngineProvider.sharedInstance.engineErrorMessage)")
+            print("Failed to initialize IINKEngine: \(EngineProvider.sharedInstance.engineErrorMessage)")
+            throw RecognitionError.engineNotInitialized
         }
         self.engine = engine
     }
-    
-    func setMode(_ mode: RecognitionMode) {
-        currentMode = mode
 
-        if !serviceCache.isEmpty {
-            serviceCache.removeAll()
-        }
+    func createSession(mode: RecognitionMode) throws -> RecognitionSession {
+        try MyScriptRecognitionSession(engine: engine, mode: mode)
     }
-    
-    func createRecognizer() -> RecognitionService {
-        let cacheKey = currentMode.mimeTypeString
-        
-        if let cachedService = serviceCache[cacheKey] {
-            return cachedService
-        }
-        
-        let service = MyScriptRecognitionService(engine: engine, mode: currentMode)
-        serviceCache[cacheKey] = service
-        
-        return service
+
+    func createStreamingSession(mode: RecognitionMode) throws -> StreamingRecognitionSession {
+        try MyScriptStreamingSession(engine: engine, mode: mode)
     }
 } 
@@ -0,0 +1,181 @@
+import Foundation
+import InkCore
+import PencilKit
+import MyScriptInteractiveInk_Runtime
+
+/// Offscreen editor for one recognition mode, with a content part for each of the last few blocks it
+/// processed. A block keeps its part, and the strokes fed into it, while other blocks come and go, so a later
+/// call for the same block only sends the strokes that changed; the least recently used part is removed once
+/// more than `RecognitionSessionLimits.heldBlocks` blocks are held.
+actor MyScriptRecognitionSession: RecognitionSession {
+    private struct FedStroke {
+        let fingerprint: StrokeFingerprint
+        let itemIds: [String]
+    }
+
+    private final class HeldBlock {
+        let part: IINKContentPart
+        var fedStrokes: [FedStroke] = []
+        var lastResult: String?
+
+        init(part: IINKContentPart) {
+            self.part = part
+        }
+    }
+
+    /// Converter coordinates are treated as 96 dpi pixels, as for the on-screen editor.
+    private static let millimetersPerUnit: Float = 25.4 / 96
+
+    private let editor: IINKOffscreenEditor
+    private let package: IINKContentPackage
+    private let mode: RecognitionMode
+    private let resampler: StrokeResampler
+    private var heldBlocks: [UUID: HeldBlock] = [:]
+    /// Least recently processed first.
+    private var recentBlockIds: [UUID] = []
+    /// Strokes sent to the editor since the session was created, including those fed again by `rebuild`.
+    private(set) var sentStrokeCount = 0
+
+    init(
+        engine: IINKEngine,
+        mode: RecognitionMode,
+        resampler: StrokeResampler = PencilKitToMyScriptConverter.defaultResampler
+    ) throws {
+        let scale = Self.millimetersPerUnit
+        self.editor = try engine.createOffscreenEditor(scaleX: scale, scaleY: scale)
+        self.package = try engine.createPackage("\(mode.description)_\(UUID().uuidString)")
+        self.mode = mode
+        self.resampler = resampler
+    }
+
+    func process(_ drawing: PKDrawing, blockId: UUID) async throws -> String {
+        if drawing.strokes.isEmpty {
+            throw RecognitionError.noStrokesToRecognize
+        }
+
+        let block = try activate(blockId)
+        let strokes = drawing.strokes
+        let fingerprints = strokes.map(StrokeFingerprint.init)
+        let diff = StrokeDiff(from: block.fedStrokes.map(\.fingerprint), to: fingerprints)
+
+        if diff.isEmpty, let lastResult = block.lastResult {
+            return lastResult
+        }
+
+        do {
+            try apply(diff, strokes: strokes, fingerprints: fingerprints, to: block)
+            let result = try export()
+            block.lastResult = result
+            return result
+        } catch {
+            // The part may be left half-updated; the next call for this block starts from an empty one.
+            removeBlock(blockId)
+            throw error
+        }
+    }
+
+    func forgetBlock(_ blockId: UUID) {
+        removeBlock(blockId)
+    }
+
+    // MARK: - Private Helpers
+    /// Binds the editor to the block's part, creating it and removing the least recently used one if needed.
+    private func activate(_ blockId: UUID) throws -> HeldBlock {
+        recentBlockIds.removeAll { $0 == blockId }
+        recentBlockIds.append(blockId)
+
+        let block: HeldBlock
+        if let heldBlock = heldBlocks[blockId] {
+            block = heldBlock
+        } else {
+            block = HeldBlock(part: try package.createPart(with: mode.partType))
+            heldBlocks[blockId] = block
+        }
+        if editor.part !== block.part {
+            try editor.set(part: block.part)
+        }
+
+        while recentBlockIds.count > RecognitionSessionLimits.heldBlocks {
+            removeBlock(recentBlockIds[0])
+        }
+        return block
+    }
+
+    private func removeBlock(_ blockId: UUID) {
+        recentBlockIds.removeAll { $0 == blockId }
+        guard let block = heldBlocks.removeValue(forKey: blockId) else { return }
+
+        if editor.part === block.part {
+            try? editor.set(part: nil)
+        }
+        do {
+            try package.removePart(block.part)
+        } catch {
+            print("Failed to remove recognition part: \(error)")
+        }
+    }
+
+    private func apply(_ diff: StrokeDiff, strokes: [PKStroke], fingerprints: [StrokeFingerprint], to block: HeldBlock) throws {
+        let removedIds = block.fedStrokes[diff.removed].flatMap(\.itemIds)
+        let insertedStrokes = Array(strokes[diff.inserted])
+        let insertedFingerprints = Array(fingerprints[diff.inserted])
+
+        var events = PencilKitToMyScriptConverter.pointerEvents(for: insertedStrokes, resampler: resampler)
+
+        if events.isEmpty {
+            if !removedIds.isEmpty {
+                try editor.erase(removedIds)
+            }
+            let inserted = insertedFingerprints.map { FedStroke(fingerprint: $0, itemIds: []) }
+            block.fedStrokes.replaceSubrange(diff.removed, with: inserted)
+            return
+        }
+
+        sentStrokeCount += insertedStrokes.count
+        let itemIds: [String]
+        if removedIds.isEmpty {
+            itemIds = try editor.addStrokes(&events, count: events.count, doProcessGestures: false)
+        } else {
+            itemIds = try editor.replaceStrokes(removedIds, events: &events, count: events.count)
+        }
+
+        guard itemIds.count == insertedStrokes.count else {
+            // Ids cannot be matched to strokes, so feed everything again one stroke at a time.
+            try rebuild(strokes: strokes, fingerprints: fingerprints, into: block)
+            return
+        }
+
+        let inserted = zip(insertedFingerprints, itemIds).map { FedStroke(fingerprint: $0, itemIds: [$1]) }
+        block.fedStrokes.replaceSubrange(diff.removed, with: inserted)
+    }
+
+    private func rebuild(strokes: [PKStroke], fingerprints: [StrokeFingerprint], into block: HeldBlock) throws {
+        editor.clear()
+        block.fedStrokes.removeAll()
+
+        for (stroke, fingerprint) in zip(strokes, fingerprints) {
+            var events = PencilKitToMyScriptConverter.pointerEvents(for: [stroke], resampler: resampler)
+            guard !events.isEmpty else {
+                block.fedStrokes.append(FedStroke(fingerprint: fingerprint, itemIds: []))
+                continue
+            }
+            sentStrokeCount += 1
+            let itemIds = try editor.addStrokes(&events, count: events.count, doProcessGestures: false)
+            block.fedStrokes.append(FedStroke(fingerprint: fingerprint, itemIds: itemIds))
+        }
+    }
+
+    private func export() throws -> String {
+        editor.waitForIdle()
+
+        guard let mimeType = mode.mimeType as? IINKMimeType else {
+            throw RecognitionError.invalidMimeType
+        }
+
+        do {
+            return try editor.export(itemIds: [], mimeType: mimeType)
+        } catch {
+            throw RecognitionError.exportFailed(underlyingError: error)
+        }
+    }
+}
@@ -0,0 +1,91 @@
+import Foundation
+import InkCore
+import PencilKit
+import MyScriptInteractiveInk_Runtime
+
+/// Streams a block's strokes into a headless `IINKRecognizer` and reports each intermediate result.
+/// The recognizer cannot erase ink, so appended strokes are sent on their own and any other change
+/// clears it and sends the whole drawing again.
+final class MyScriptStreamingSession: NSObject, StreamingRecognitionSession, IINKRecognizerDelegate {
+    /// Called on the main queue.
+    var onPartialResult: ((String) -> Void)?
+
+    private static let millimetersPerUnit: Float = 25.4 / 96
+
+    private let recognizer: IINKRecognizer
+    private let mode: RecognitionMode
+    private let queue = DispatchQueue(label: "com.trofimpetyanov.alwrite.streaming-recognition", qos: .userInitiated)
+    private var fedFingerprints: [StrokeFingerprint] = []
+
+    init(engine: IINKEngine, mode: RecognitionMode) throws {
+        let scale = Self.millimetersPerUnit
+        self.recognizer = try engine.createRecognizer(scaleX: scale, scaleY: scale, type: mode.partType)
+        self.mode = mode
+        super.init()
+        recognizer.addDelegate(self)
+    }
+
+    deinit {
+        recognizer.removeDelegate(self)
+    }
+
+    func update(_ drawing: PKDrawing) {
+        let strokes = drawing.strokes
+        queue.async { [weak self] in
+            self?.feed(strokes)
+        }
+    }
+
+    // MARK: - IINKRecognizerDelegate
+    func resultChanged(_ recognizer: IINKRecognizer, result: String) {
+        queue.async { [weak self] in
+            guard let self, let text = self.currentResult(jiix: result) else { return }
+            DispatchQueue.main.async {
+                self.onPartialResult?(text)
+            }
+        }
+    }
+
+    func onError(_ recognizer: IINKRecognizer, code: IINKRecognizerError, message: String) {
+        print("Streaming recognizer error \(code.rawValue): \(message)")
+    }
+
+    // MARK: - Private Helpers
+    private func feed(_ strokes: [PKStroke]) {
+        let fingerprints = strokes.map(StrokeFingerprint.init)
+        let diff = StrokeDiff(from: fedFingerprints, to: fingerprints)
+        guard !diff.isEmpty else { return }
+
+        do {
+            let isAppend = diff.removed.isEmpty && diff.inserted.upperBound == strokes.count
+            if !isAppend {
+                try recognizer.clear()
+            }
+
+            let newStrokes = isAppend ? Array(strokes[diff.inserted]) : strokes
+            var events = PencilKitToMyScriptConverter.pointerEvents(for: newStrokes)
+            if !events.isEmpty {
+                try recognizer.pointerEvents(&events, count: events.count)
+            }
+            fedFingerprints = fingerprints
+        } catch {
+            print("Failed to stream strokes: \(error.localizedDescription)")
+            fedFingerprints.removeAll()
+            try? recognizer.clear()
+        }
+    }
+
+    /// Prefers the mode's export format and falls back to the label of the JIIX result passed to the delegate.
+    private func currentResult(jiix: String) -> String? {
+        if let mimeType = mode.mimeType as? IINKMimeType,
+           let result = try? recognizer.result(mimeType: mimeType) {
+            return result
+        }
+
+        guard let data = jiix.data(using: .utf8),
+              let object = try? JSONSerialization.jsonObject(with: data) as? [String: Any] else {
+            return nil
+        }
+        return object["label"] as? String
+    }
+}
@@ -1,69 +1,103 @@
 import Foundation
+import InkCore
 import PencilKit
 import MyScriptInteractiveInk_Runtime
 
 final class PencilKitToMyScriptConverter {
-    
-    static func convertDrawing(_ drawing: PKDrawing, to editor: IINKEditor) throws {
+    /// Passes strokes through unchanged. `ResamplingAccuracyBenchmark` compares it with Douglas–Peucker
+    /// decimation on a recorded notebook; switch here once a setting keeps the recognized text.
+    static let defaultResampler: StrokeResampler = PassthroughResampler()
+
+    static func convertDrawing(
+        _ drawing: PKDrawing,
+        to editor: IINKEditor,
+        resampler: StrokeResampler = defaultResampler
+    ) throws {
         for i in 0..<10 {
             try? editor.pointerCancel(i)
         }
-        
-        for (index, stroke) in drawing.strokes.enumerated() {
-            let pointerId = (index % 9) + 1
-            try convertStroke(stroke, to: editor, pointerId: Int32(pointerId))
-            try editor.pointerCancel(pointerId)
-        }
+
+        var events = pointerEvents(for: drawing.strokes, resampler: resampler)
+        guard !events.isEmpty else { return }
+        try editor.pointerEvents(&events, count: events.count, doProcessGestures: false)
+    }
+
+    static func convertDrawing(
+        _ drawing: PKDrawing,
+        to recognizer: IINKRecognizer,
+        resampler: StrokeResampler = defaultResampler
+    ) throws {
+        try? recognizer.pointerCancel()
+
+        var events = pointerEvents(for: drawing.strokes, resampler: resampler)
+        guard !events.isEmpty else { return }
+        try recognizer.pointerEvents(&events, count: events.count)
     }
-    
+
     static func convertStroke(_ stroke: PKStroke, to editor: IINKEditor, pointerId: Int32 = 0) throws {
-        let path = stroke.path
-        
-        let interpolatedPoints = path.interpolatedPoints(in: nil, by: .distance(1.0))
-        let pointsArray = Array(interpolatedPoints)
-        
-        guard !pointsArray.isEmpty else {
-            return
+        var events = pointerEvents(for: [stroke], pointerId: pointerId)
+        guard !events.isEmpty else { return }
+        try editor.pointerEvents(&events, count: events.count, doProcessGestures: false)
+    }
+
+    /// Builds down/move/up events for `strokes` into one contiguous buffer, timestamped from the strokes' own
+    /// timing, so a whole drawing crosses the bridge in a single `pointerEvents` call. Each stroke goes through
+    /// `resampler` between sampling and event creation.
+    static func pointerEvents(
+        for strokes: [PKStroke],
+        pointerId: Int32 = 0,
+        resampler: StrokeResampler = defaultResampler
+    ) -> [IINKPointerEvent] {
+        let sampledStrokes = strokes.map { stroke in
+            (startTime: stroke.path.creationDate.timeIntervalSince1970, samples: resampler.resample(samples(of: stroke)))
         }
 
-        let startTimestamp = Int64(Date().timeIntervalSince1970 * 1000)
-        
-        let firstPoint = pointsArray.first!
-        try editor.pointerDown(
-            point: CGPoint(x: firstPoint.location.x, y: firstPoint.location.y),
-            timestamp: startTimestamp,
-            force: Float(firstPoint.force),
-            type: .pen,
-            pointerId: Int(pointerId)
-        )
+        var events: [IINKPointerEvent] = []
+        events.reserveCapacity(sampledStrokes.reduce(0) { $0 + max($1.samples.count, 2) })
+        for sampled in sampledStrokes {
+            appendPointerEvents(for: sampled.samples, startTime: sampled.startTime, pointerId: pointerId, to: &events)
+        }
+        return events
+    }
 
-        let timeStep: Int64 = 10
-        var timestamp = startTimestamp
-        
-        for point in pointsArray.dropFirst().dropLast() {
-            timestamp += timeStep
-            try editor.pointerMove(
-                point: CGPoint(x: point.location.x, y: point.location.y),
-                timestamp: timestamp,
-                force: Float(point.force),
-                type: .pen,
-                pointerId: Int(pointerId)
-            )
+    static func samples(of stroke: PKStroke) -> StrokeSampleBuffer {
+        StrokeSampleBuffer(stroke, interpolationDistance: 1.0)
+    }
+
+    private static func appendPointerEvents(
+        for samples: StrokeSampleBuffer,
+        startTime: TimeInterval,
+        pointerId: Int32,
+        to events: inout [IINKPointerEvent]
+    ) {
+        guard samples.count > 0 else {
+            return
         }
-        
-        if pointsArray.count > 1 {
-            let lastPoint = pointsArray.last!
-            timestamp += timeStep
-            try editor.pointerUp(
-                point: CGPoint(x: lastPoint.location.x, y: lastPoint.location.y),
-                timestamp: timestamp,
-                force: Float(lastPoint.force),
-                type: .pen,
-                pointerId: Int(pointerId)
+
+        func event(_ type: IINKPointerEventType, _ index: Int) -> IINKPointerEvent {
+            IINKPointerEvent(
+                eventType: type,
+                x: samples.x[index],
+                y: samples.y[index],
+                t: Int64((startTime + samples.timeOffset[index]) * 1000),
+                f: samples.force[index],
+                tilt: -1,
+                orientation: -10,
+                pointerType: .pen,
+                pointerId: pointerId
             )
         }
+
+        let lastIndex = samples.count - 1
+        events.append(event(.down, 0))
+        if lastIndex > 1 {
+            for index in 1..<lastIndex {
+                events.append(event(.move, index))
+            }
+        }
+        events.append(event(.up, lastIndex))
     }
-    
+
     static func addStroke(_ stroke: PKStroke, to editor: IINKEditor) throws {
         try? editor.pointerCancel(1)
         try convertStroke(stroke, to: editor, pointerId: 1)
@@ -0,0 +1,114 @@
+import Combine
+import Foundation
+
+/// Brings the recognition engine up off the main thread, started at launch so the first recognition
+/// does not pay for certificate checks, asset lookup and editor creation.
+///
+/// One session per recognition mode is created along with the engine and handed to the first worker.
+/// Sessions for the other workers are created on the same background queue through `makeSession(mode:engine:)`.
+@MainActor
+final class RecognitionBootstrap {
+    enum State: Equatable {
+        case idle
+        case warmingUp
+        case ready
+        case failed(String)
+    }
+
+    static let shared = RecognitionBootstrap(engineFactory: RecognitionEngineFactory())
+
+    @Published private(set) var state: State = .idle
+    private(set) var engine: RecognitionEngine?
+
+    private let engineFactory: RecognitionEngineFactory?
+    private var warmSessions: [StandardRecognitionMode: RecognitionSession] = [:]
+    private var readinessWaiters: [CheckedContinuation<RecognitionEngine, Error>] = []
+    private let queue = DispatchQueue(label: "com.trofimpetyanov.alwrite.recognition-bootstrap", qos: .userInitiated)
+
+    init(engineFactory: RecognitionEngineFactory) {
+        self.engineFactory = engineFactory
+    }
+
+    /// Wraps an engine that is already usable; sessions are then created on first use.
+    init(readyEngine: RecognitionEngine) {
+        self.engineFactory = nil
+        self.engine = readyEngine
+        self.state = .ready
+    }
+
+    func start() {
+        guard state == .idle, let engineFactory else { return }
+        state = .warmingUp
+
+        queue.async {
+            let result = Result { try Self.warmUp(with: engineFactory) }
+            DispatchQueue.main.async {
+                self.finish(result)
+            }
+        }
+    }
+
+    /// Waits for the engine, starting the bootstrap if nothing did yet.
+    func readyEngine() async throws -> RecognitionEngine {
+        if let engine {
+            return engine
+        }
+        if case .failed = state {
+            throw RecognitionError.engineNotInitialized
+        }
+
+        start()
+        return try await withCheckedThrowingContinuation { continuation in
+            readinessWaiters.append(continuation)
+        }
+    }
+
+    /// Hands out the pre-created sessions once; later callers create their own.
+    func takeWarmSessions() -> [StandardRecognitionMode: RecognitionSession] {
+        defer { warmSessions.removeAll() }
+        return warmSessions
+    }
+
+    /// Creating a session builds an offscreen editor, which is too slow for the main thread.
+    func makeSession(mode: StandardRecognitionMode, engine: RecognitionEngine) async throws -> RecognitionSession {
+        try await withCheckedThrowingContinuation { continuation in
+            queue.async {
+                continuation.resume(with: Result { try engine.createSession(mode: mode) })
+            }
+        }
+    }
+
+    // MARK: - Private Helpers
+    private nonisolated static func warmUp(
+        with engineFactory: RecognitionEngineFactory
+    ) throws -> (engine: RecognitionEngine, sessions: [StandardRecognitionMode: RecognitionSession]) {
+        let engine = try engineFactory.createDefaultEngine()
+
+        var sessions: [StandardRecognitionMode: RecognitionSession] = [:]
+        for mode in StandardRecognitionMode.allCases {
+            do {
+                sessions[mode] = try engine.createSession(mode: mode)
+            } catch {
+                print("Failed to prepare \(mode.description) session: \(error)")
+            }
+        }
+        return (engine, sessions)
+    }
+
+    private func finish(_ result: Result<(engine: RecognitionEngine, sessions: [StandardRecognitionMode: RecognitionSession]), Error>) {
+        let waiters = readinessWaiters
+        readinessWaiters.removeAll()
+
+        switch result {
+        case .success(let warmedUp):
+            engine = warmedUp.engine
+            warmSessions = warmedUp.sessions
+            state = .ready
+            waiters.forEach { $0.resume(returning: warmedUp.engine) }
+        case .failure(let error):
+            print("Recognition engine bootstrap failed: \(error)")
+            state = .failed(error.localizedDescription)
+            waiters.forEach { $0.resume(throwing: error) }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+import Foundation
+import os
+
+/// Measures the time from a pen-up in a block to the first recognized text shown for it.
+/// Each measurement is an Instruments signpost interval and is kept in a rolling window. Every `reportInterval`
+/// measurements the window's p50 and p95 are emitted as a "PenUpToTextSummary" signpost event, and printed
+/// as well when the app is launched with `ALWRITE_RECOGNITION_LATENCY_LOG` set.
+@MainActor
+final class RecognitionLatencyTracker {
+    static let loggingEnvironmentKey = "ALWRITE_RECOGNITION_LATENCY_LOG"
+    private static let signposter = OSSignposter(subsystem: "com.trofimpetyanov.alwrite", category: "Recognition")
+
+    /// Prints the summary as well as emitting it.
+    var isLoggingEnabled = ProcessInfo.processInfo.environment[RecognitionLatencyTracker.loggingEnvironmentKey] != nil
+    var reportInterval = 20
+
+    private let windowSize: Int
+    private var penUps: [UUID: (time: TimeInterval, state: OSSignpostIntervalState)] = [:]
+    private(set) var samples: [TimeInterval] = []
+    private var samplesSinceReport = 0
+
+    init(windowSize: Int = 200) {
+        self.windowSize = windowSize
+    }
+
+    /// Only the first pen-up since the block's text was last shown starts a measurement.
+    func penUp(in blockId: UUID) {
+        guard penUps[blockId] == nil else { return }
+        let state = Self.signposter.beginInterval("PenUpToText", id: Self.signposter.makeSignpostID())
+        penUps[blockId] = (ProcessInfo.processInfo.systemUptime, state)
+    }
+
+    func textShown(in blockId: UUID) {
+        guard let penUp = penUps.removeValue(forKey: blockId) else { return }
+        Self.signposter.endInterval("PenUpToText", penUp.state)
+
+        samples.append(ProcessInfo.processInfo.systemUptime - penUp.time)
+        if samples.count > windowSize {
+            samples.removeFirst(samples.count - windowSize)
+        }
+
+        samplesSinceReport += 1
+        if samplesSinceReport >= reportInterval {
+            samplesSinceReport = 0
+            report()
+        }
+    }
+
+    func cancel(for blockId: UUID) {
+        guard let penUp = penUps.removeValue(forKey: blockId) else { return }
+        Self.signposter.endInterval("PenUpToText", penUp.state)
+    }
+
+    func percentile(_ fraction: Double) -> TimeInterval? {
+        guard !samples.isEmpty else { return nil }
+        let sorted = samples.sorted()
+        let index = Int((Double(sorted.count - 1) * min(max(fraction, 0), 1)).rounded())
+        return sorted[index]
+    }
+
+    // MARK: - Private Helpers
+    private func report() {
+        guard let median = percentile(0.5), let p95 = percentile(0.95) else { return }
+        let summary = String(
+            format: "pen-up to text over %d samples: p50 %.0f ms, p95 %.0f ms",
+            samples.count, median * 1000, p95 * 1000
+        )
+        Self.signposter.emitEvent("PenUpToTextSummary", "\(summary, privacy: .public)")
+        if isLoggingEnabled {
+            print(summary)
+        }
+    }
+}
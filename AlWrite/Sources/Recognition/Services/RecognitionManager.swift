@@ -1,52 +1,108 @@
 import Foundation
+import InkCore
 import PencilKit
 
 @MainActor
 protocol HandwritingRecognizer: AnyObject {
-    func setRecognitionMode(_ mode: StandardRecognitionMode)
-    func processDrawing(_ drawing: PKDrawing) async throws -> String
+    var maxConcurrentJobs: Int { get }
+    func recognize(_ job: RecognitionJob) async throws -> String
+    func streamPartialResults(of job: RecognitionJob, handler: @escaping (String) -> Void)
+    func forgetBlock(_ blockId: UUID)
 }
 
 @MainActor
 class HandwritingRecognitionManager: HandwritingRecognizer {
-    private let recognitionEngine: RecognitionEngine
-    private var recognitionService: RecognitionService
-    private var isServiceInitialized = false
-    
-    init(engineFactory: RecognitionEngineFactory = RecognitionEngineFactory()) {
-        self.recognitionEngine = engineFactory.createDefaultEngine()
-        self.recognitionService = recognitionEngine.createRecognizer()
-    }
+    private let bootstrap: RecognitionBootstrap
+    private let poolSize: Int
+    /// Created once the engine is ready.
+    private var workerPool: RecognitionWorkerPool?
+    private let resultCache: RecognitionResultCache
+    /// Only the block being written in streams; switching blocks replaces the session.
+    private var streamingSession: (blockId: UUID, mode: StandardRecognitionMode, session: StreamingRecognitionSession)?
 
-    private func reinitializeService() {
-        self.recognitionService = recognitionEngine.createRecognizer()
-        isServiceInitialized = true
+    var maxConcurrentJobs: Int {
+        poolSize
     }
     
-    func setRecognitionMode(_ mode: StandardRecognitionMode) {
-        recognitionEngine.setMode(mode)
-        self.recognitionService = recognitionEngine.createRecognizer()
-        isServiceInitialized = true
+    init(
+        bootstrap: RecognitionBootstrap = .shared,
+        poolSize: Int = RecognitionWorkerPool.defaultSize,
+        resultCache: RecognitionResultCache = RecognitionResultCache()
+    ) {
+        self.bootstrap = bootstrap
+        self.poolSize = max(1, poolSize)
+        self.resultCache = resultCache
+    }
+
+    convenience init(
+        engine: RecognitionEngine,
+        poolSize: Int = RecognitionWorkerPool.defaultSize,
+        resultCache: RecognitionResultCache = RecognitionResultCache()
+    ) {
+        self.init(bootstrap: RecognitionBootstrap(readyEngine: engine), poolSize: poolSize, resultCache: resultCache)
     }
-    
-    func processDrawing(_ drawing: PKDrawing) async throws -> String {
-        if !isServiceInitialized {
-            reinitializeService()
-        }
 
-        if drawing.strokes.isEmpty {
+    func recognize(_ job: RecognitionJob) async throws -> String {
+        if job.drawing.strokes.isEmpty {
             throw RecognitionError.noStrokesToRecognize
         }
-        
+
+        let engine = try await bootstrap.readyEngine()
+        let cacheKey = RecognitionCacheKey(
+            contentHash: StrokeContentHash(job.drawing).value,
+            mode: job.mode.mimeTypeString,
+            language: engine.language,
+            assetVersion: engine.assetVersion
+        )
+        if let cachedResult = await resultCache.result(for: cacheKey) {
+            return cachedResult
+        }
+
+        let result = try await workerPool(for: engine).run(job)
+        resultCache.store(result, for: cacheKey)
+        return result
+    }
+
+    /// Partial results start once the engine is ready; until then only the final pass reports text.
+    func streamPartialResults(of job: RecognitionJob, handler: @escaping (String) -> Void) {
+        guard let recognitionEngine = bootstrap.engine else { return }
+
+        if let current = streamingSession, current.blockId == job.blockId, current.mode == job.mode {
+            current.session.onPartialResult = handler
+            current.session.update(job.drawing)
+            return
+        }
+
         do {
-            return try await recognitionService.processDrawing(drawing)
+            let session = try recognitionEngine.createStreamingSession(mode: job.mode)
+            session.onPartialResult = handler
+            session.update(job.drawing)
+            streamingSession = (blockId: job.blockId, mode: job.mode, session: session)
         } catch {
-            if error is RecognitionError {
-                print("Recognition failed, retrying after reinitialization...")
-                reinitializeService()
-                return try await recognitionService.processDrawing(drawing)
-            }
-            throw error
+            streamingSession = nil
+            print("Failed to start streaming recognition: \(error.localizedDescription)")
+        }
+    }
+
+    func forgetBlock(_ blockId: UUID) {
+        workerPool?.forgetBlock(blockId)
+        if streamingSession?.blockId == blockId {
+            streamingSession = nil
+        }
+    }
+
+    // MARK: - Private Helpers
+    private func workerPool(for engine: RecognitionEngine) -> RecognitionWorkerPool {
+        if let workerPool {
+            return workerPool
+        }
+        let pool = RecognitionWorkerPool(
+            size: poolSize,
+            warmSessions: bootstrap.takeWarmSessions()
+        ) { [bootstrap] mode in
+            try await bootstrap.makeSession(mode: mode, engine: engine)
         }
+        workerPool = pool
+        return pool
     }
 }
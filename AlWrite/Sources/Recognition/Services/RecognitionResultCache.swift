@@ -0,0 +1,131 @@
+import Foundation
+import InkCore
+
+/// Content-addressed store of exported recognition results, kept on disk across launches.
+/// The least recently used entries are removed once the store grows past `maxBytes`.
+///
+/// All disk access happens on the cache's own queue: the index is loaded there as soon as the cache is
+/// created, and lookups that miss the memory cache suspend the caller instead of blocking it.
+final class RecognitionResultCache {
+    private struct Entry {
+        var size: Int
+        var lastAccess: Date
+    }
+
+    private let directory: URL
+    private let maxBytes: Int
+    private let fileManager = FileManager.default
+    private let queue = DispatchQueue(label: "com.trofimpetyanov.alwrite.recognition-cache")
+    private let memoryCache = NSCache<NSString, NSString>()
+    private var entries: [String: Entry]?
+    private var totalBytes = 0
+
+    init(directory: URL? = nil, maxBytes: Int = 16 * 1024 * 1024) {
+        let cachesDirectory = fileManager.urls(for: .cachesDirectory, in: .userDomainMask).first
+            ?? URL(fileURLWithPath: NSTemporaryDirectory())
+        self.directory = directory ?? cachesDirectory.appendingPathComponent("RecognitionResults", isDirectory: true)
+        self.maxBytes = maxBytes
+        memoryCache.countLimit = 512
+
+        queue.async { [self] in
+            loadIndexIfNeeded()
+        }
+    }
+
+    func result(for key: RecognitionCacheKey) async -> String? {
+        let name = key.fileName
+        if let cached = memoryCache.object(forKey: name as NSString) {
+            touch(name)
+            return cached as String
+        }
+
+        return await withCheckedContinuation { continuation in
+            queue.async { [self] in
+                continuation.resume(returning: readResult(named: name))
+            }
+        }
+    }
+
+    func store(_ result: String, for key: RecognitionCacheKey) {
+        let name = key.fileName
+        memoryCache.setObject(result as NSString, forKey: name as NSString)
+
+        queue.async { [self] in
+            loadIndexIfNeeded()
+            let data = Data(result.utf8)
+            do {
+                try data.write(to: fileURL(for: name), options: .atomic)
+            } catch {
+                print("Failed to store recognition result: \(error.localizedDescription)")
+                return
+            }
+
+            totalBytes += data.count - (entries?[name]?.size ?? 0)
+            entries?[name] = Entry(size: data.count, lastAccess: Date())
+            evictIfNeeded()
+        }
+    }
+
+    // MARK: - Private Helpers
+    private func readResult(named name: String) -> String? {
+        loadIndexIfNeeded()
+        guard entries?[name] != nil,
+              let data = try? Data(contentsOf: fileURL(for: name)) else {
+            return nil
+        }
+        let text = String(decoding: data, as: UTF8.self)
+        memoryCache.setObject(text as NSString, forKey: name as NSString)
+        markAccessed(name)
+        return text
+    }
+
+    private func fileURL(for name: String) -> URL {
+        directory.appendingPathComponent(name)
+    }
+
+    private func touch(_ name: String) {
+        queue.async { [self] in
+            loadIndexIfNeeded()
+            markAccessed(name)
+        }
+    }
+
+    private func markAccessed(_ name: String) {
+        guard entries?[name] != nil else { return }
+        let now = Date()
+        entries?[name]?.lastAccess = now
+        try? fileManager.setAttributes([.modificationDate: now], ofItemAtPath: fileURL(for: name).path)
+    }
+
+    private func loadIndexIfNeeded() {
+        guard entries == nil else { return }
+
+        var loaded: [String: Entry] = [:]
+        totalBytes = 0
+        try? fileManager.createDirectory(at: directory, withIntermediateDirectories: true)
+
+        let keys: [URLResourceKey] = [.fileSizeKey, .contentModificationDateKey]
+        let urls = (try? fileManager.contentsOfDirectory(at: directory, includingPropertiesForKeys: keys)) ?? []
+        for url in urls {
+            let values = try? url.resourceValues(forKeys: Set(keys))
+            let size = values?.fileSize ?? 0
+            loaded[url.lastPathComponent] = Entry(size: size, lastAccess: values?.contentModificationDate ?? .distantPast)
+            totalBytes += size
+        }
+
+        entries = loaded
+        evictIfNeeded()
+    }
+
+    private func evictIfNeeded() {
+        guard totalBytes > maxBytes, let current = entries else { return }
+
+        for (name, entry) in current.sorted(by: { $0.value.lastAccess < $1.value.lastAccess }) {
+            guard totalBytes > maxBytes else { break }
+            try? fileManager.removeItem(at: fileURL(for: name))
+            memoryCache.removeObject(forKey: name as NSString)
+            entries?[name] = nil
+            totalBytes -= entry.size
+        }
+    }
+}
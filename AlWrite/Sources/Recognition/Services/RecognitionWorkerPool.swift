@@ -0,0 +1,199 @@
+import Foundation
+import InkCore
+
+/// Owns one session, and so one offscreen editor, per recognition mode. Sessions handed in
+/// pre-warmed are used as is, the others come from `makeSession`, which creates them off the main thread.
+/// A worker runs a single job at a time; the pool guarantees exclusive access.
+@MainActor
+final class RecognitionWorker {
+    typealias SessionFactory = (StandardRecognitionMode) async throws -> RecognitionSession
+
+    private let makeSession: SessionFactory
+    private var sessions: [StandardRecognitionMode: RecognitionSession] = [:]
+    /// Sessions being created, so a job and a prewarm for the same mode share one editor.
+    private var sessionTasks: [StandardRecognitionMode: Task<RecognitionSession, Error>] = [:]
+    /// Blocks whose strokes each session holds, least recently processed first. Trimmed to the same limit
+    /// as the sessions themselves, so it lists what they keep.
+    private var heldBlockIds: [StandardRecognitionMode: [UUID]] = [:]
+
+    init(warmSessions: [StandardRecognitionMode: RecognitionSession] = [:], makeSession: @escaping SessionFactory) {
+        self.sessions = warmSessions
+        self.makeSession = makeSession
+    }
+
+    func hasSession(for mode: StandardRecognitionMode) -> Bool {
+        sessions[mode] != nil
+    }
+
+    func holdsBlock(_ blockId: UUID, mode: StandardRecognitionMode) -> Bool {
+        heldBlockIds[mode]?.contains(blockId) ?? false
+    }
+
+    func process(_ job: RecognitionJob) async throws -> String {
+        let session = try await session(for: job.mode)
+        var held = heldBlockIds[job.mode] ?? []
+        held.removeAll { $0 == job.blockId }
+        held.append(job.blockId)
+        heldBlockIds[job.mode] = Array(held.suffix(RecognitionSessionLimits.heldBlocks))
+
+        do {
+            return try await session.process(job.drawing, blockId: job.blockId)
+        } catch {
+            // The session starts this block over from an empty part next time.
+            heldBlockIds[job.mode]?.removeAll { $0 == job.blockId }
+            throw error
+        }
+    }
+
+    /// Creates the sessions this worker does not have yet, one after the other.
+    func prepareSessions(for modes: [StandardRecognitionMode]) async {
+        for mode in modes where sessions[mode] == nil {
+            do {
+                _ = try await session(for: mode)
+            } catch {
+                print("Failed to prepare \(mode.description) session: \(error)")
+            }
+        }
+    }
+
+    func forgetBlock(_ blockId: UUID) {
+        for (mode, session) in sessions where holdsBlock(blockId, mode: mode) {
+            heldBlockIds[mode]?.removeAll { $0 == blockId }
+            Task { await session.forgetBlock(blockId) }
+        }
+    }
+
+    private func session(for mode: StandardRecognitionMode) async throws -> RecognitionSession {
+        if let session = sessions[mode] {
+            return session
+        }
+        if let task = sessionTasks[mode] {
+            return try await task.value
+        }
+
+        let task = Task { try await makeSession(mode) }
+        sessionTasks[mode] = task
+        defer { sessionTasks[mode] = nil }
+
+        let session = try await task.value
+        sessions[mode] = session
+        return session
+    }
+}
+
+/// Bounded set of recognition workers. Jobs for a block go back to the worker that already holds its
+/// strokes when it is free, so only the changed strokes have to be sent again; other jobs prefer a worker
+/// that already has a session for their mode. Workers without pre-warmed sessions get theirs in the
+/// background right after the pool is created.
+///
+/// When every worker is busy, jobs wait by priority, then in arrival order; a worker that frees up takes a job
+/// of the first waiting priority whose block it holds before the others. A waiting job that is cancelled
+/// leaves the queue at once; a job already inside the engine keeps its worker until the engine returns.
+@MainActor
+final class RecognitionWorkerPool {
+    static var defaultSize: Int {
+        max(1, min(ProcessInfo.processInfo.activeProcessorCount - 1, 4))
+    }
+
+    private struct WaitingJob {
+        let id: Int
+        let blockId: UUID
+        let mode: StandardRecognitionMode
+        let priority: RecognitionPriority
+        let continuation: CheckedContinuation<Int?, Never>
+    }
+
+    private let workers: [RecognitionWorker]
+    private var idleWorkerIndices: Set<Int>
+    private var waitingJobs: [WaitingJob] = []
+    private var nextWaiterId = 0
+
+    var size: Int {
+        workers.count
+    }
+
+    init(
+        size: Int = RecognitionWorkerPool.defaultSize,
+        warmSessions: [StandardRecognitionMode: RecognitionSession] = [:],
+        makeSession: @escaping RecognitionWorker.SessionFactory
+    ) {
+        let size = max(1, size)
+        self.workers = (0..<size).map { index in
+            RecognitionWorker(warmSessions: index == 0 ? warmSessions : [:], makeSession: makeSession)
+        }
+        self.idleWorkerIndices = Set(0..<size)
+        prewarmWorkers()
+    }
+
+    func run(_ job: RecognitionJob) async throws -> String {
+        guard let index = await acquireWorker(for: job) else {
+            throw CancellationError()
+        }
+        defer { releaseWorker(index) }
+
+        try Task.checkCancellation()
+        return try await workers[index].process(job)
+    }
+
+    func forgetBlock(_ blockId: UUID) {
+        workers.forEach { $0.forgetBlock(blockId) }
+    }
+
+    // MARK: - Private Helpers
+    /// One worker at a time, so the bootstrap queue is never flooded while recognition is starting.
+    private func prewarmWorkers() {
+        let workers = workers
+        Task { @MainActor in
+            for worker in workers {
+                await worker.prepareSessions(for: StandardRecognitionMode.allCases)
+            }
+        }
+    }
+
+    /// `nil` when the job was cancelled while waiting.
+    private func acquireWorker(for job: RecognitionJob) async -> Int? {
+        let holdingIndex = idleWorkerIndices.first { workers[$0].holdsBlock(job.blockId, mode: job.mode) }
+        let warmIndex = idleWorkerIndices.filter { workers[$0].hasSession(for: job.mode) }.min()
+        if let index = holdingIndex ?? warmIndex ?? idleWorkerIndices.min() {
+            idleWorkerIndices.remove(index)
+            return index
+        }
+
+        let id = nextWaiterId
+        nextWaiterId += 1
+        return await withTaskCancellationHandler {
+            await withCheckedContinuation { continuation in
+                if Task.isCancelled {
+                    continuation.resume(returning: nil)
+                    return
+                }
+                // After every job of the same or higher priority, so equal priorities stay first in, first out.
+                let position = waitingJobs.firstIndex { $0.priority < job.priority } ?? waitingJobs.endIndex
+                let waitingJob = WaitingJob(
+                    id: id, blockId: job.blockId, mode: job.mode, priority: job.priority, continuation: continuation
+                )
+                waitingJobs.insert(waitingJob, at: position)
+            }
+        } onCancel: {
+            Task { @MainActor [weak self] in
+                self?.cancelWaitingJob(id)
+            }
+        }
+    }
+
+    private func cancelWaitingJob(_ id: Int) {
+        guard let position = waitingJobs.firstIndex(where: { $0.id == id }) else { return }
+        waitingJobs.remove(at: position).continuation.resume(returning: nil)
+    }
+
+    private func releaseWorker(_ index: Int) {
+        guard let next = waitingJobs.first else {
+            idleWorkerIndices.insert(index)
+            return
+        }
+        let position = waitingJobs
+            .prefix { $0.priority == next.priority }
+            .firstIndex { workers[index].holdsBlock($0.blockId, mode: $0.mode) } ?? 0
+        waitingJobs.remove(at: position).continuation.resume(returning: index)
+    }
+}
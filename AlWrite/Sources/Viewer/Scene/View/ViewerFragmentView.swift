@@ -0,0 +1,29 @@
+import SwiftUI
+import LaTeXSwiftUI
+
+struct ViewerFragmentView: View {
+    let fragment: ViewerFragment
+    let renderCache: ViewerRenderCache
+
+    var body: some View {
+        if fragment.text.isEmpty {
+            Color.clear
+                .frame(height: 0)
+        } else {
+            LaTeX(fragment.text)
+                .frame(maxWidth: .infinity, alignment: .topLeading)
+                .frame(minHeight: renderCache.height(for: fragment.key), alignment: .topLeading)
+                .background {
+                    GeometryReader { proxy in
+                        Color.clear
+                            .onAppear {
+                                renderCache.setHeight(proxy.size.height, for: fragment.key)
+                            }
+                            .onChange(of: proxy.size.height) { _, height in
+                                renderCache.setHeight(height, for: fragment.key)
+                            }
+                    }
+                }
+        }
+    }
+}
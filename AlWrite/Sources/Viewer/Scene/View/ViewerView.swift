@@ -1,9 +1,10 @@
+import InkCore
 import SwiftUI
-import LaTeXSwiftUI
 
 struct ViewerView: View {
-    @ObservedObject var viewStore: ViewStore<DocumentState, DocumentEvent>
-    @State private var refreshCounter: Int = 0
+    @ObservedObject var recognizedOutput: ViewStoreScope<RecognizedOutput>
+    @ObservedObject var isRecognitionLoading: ViewStoreScope<Bool>
+    @StateObject private var renderCache = ViewerRenderCache()
 
     var body: some View {
         VStack {
@@ -11,19 +12,22 @@ struct ViewerView: View {
         }
         .background(Color(.secondarySystemBackground))
         .onAppear {
-            refreshCounter += 1
+            renderCache.apply(recognizedOutput.value)
         }
-        .onChange(of: viewStore.state.combinedRecognizedText) { _, _ in
-            refreshCounter += 1
+        .onChange(of: recognizedOutput.value) { _, _ in
+            renderCache.apply(recognizedOutput.value)
         }
     }
 
     private var document: some View {
         ScrollView {
-            LaTeX(viewStore.state.combinedRecognizedText)
-                .id("latex_\(refreshCounter)")
-                .padding()
-                .frame(maxWidth: .infinity, alignment: .topLeading)
+            LazyVStack(alignment: .leading, spacing: 16) {
+                ForEach(renderCache.fragments) { fragment in
+                    ViewerFragmentView(fragment: fragment, renderCache: renderCache)
+                }
+            }
+            .padding()
+            .frame(maxWidth: .infinity, alignment: .topLeading)
         }
         .frame(maxWidth: .infinity, maxHeight: .infinity)
         .background(Color(.systemBackground))
@@ -31,7 +35,7 @@ struct ViewerView: View {
         .padding(.horizontal)
         .padding(.vertical)
         .overlay {
-            if viewStore.state.isRecognitionLoading {
+            if isRecognitionLoading.value {
                 ProgressView()
                     .scaleEffect(1.5)
             }
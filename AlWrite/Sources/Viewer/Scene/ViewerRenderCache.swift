@@ -0,0 +1,80 @@
+import InkCore
+import SwiftUI
+
+struct ViewerFragment: Identifiable, Equatable {
+    struct Key: Hashable {
+        let blockId: UUID
+        let textHash: UInt64
+    }
+
+    let key: Key
+    let text: String
+
+    var id: Key { key }
+
+    init(blockId: UUID, text: String) {
+        var hasher = FNV1aHasher()
+        hasher.combine(text)
+        self.key = Key(blockId: blockId, textHash: hasher.value)
+        self.text = text
+    }
+}
+
+/// Per-block fragments of the viewer, keyed by (block id, text hash).
+///
+/// A fragment keeps its key, and so its rendered view, until its block's text changes. Laid-out heights are
+/// remembered per key, so a fragment scrolled back into view reserves its size before it is typeset again.
+@MainActor
+final class ViewerRenderCache: ObservableObject {
+    @Published private(set) var fragments: [ViewerFragment] = []
+
+    private var indexByBlockId: [UUID: Int] = [:]
+    private var appliedOutput: RecognizedOutput?
+    private var heights: [ViewerFragment.Key: CGFloat] = [:]
+
+    func apply(_ output: RecognizedOutput) {
+        guard output != appliedOutput else { return }
+        defer { appliedOutput = output }
+
+        // Only a single-block change that directly follows the applied revision of the same output can be spliced in.
+        if let appliedOutput, output.hasSameLineage(as: appliedOutput), output.revision == appliedOutput.revision + 1,
+           let blockId = output.lastChange?.blockId,
+           let index = indexByBlockId[blockId],
+           let text = output.segment(for: blockId)?.text {
+            let fragment = ViewerFragment(blockId: blockId, text: text)
+            if fragment != fragments[index] {
+                heights[fragments[index].key] = nil
+                fragments[index] = fragment
+            }
+            return
+        }
+
+        rebuild(from: output)
+    }
+
+    func height(for key: ViewerFragment.Key) -> CGFloat? {
+        heights[key]
+    }
+
+    func setHeight(_ height: CGFloat, for key: ViewerFragment.Key) {
+        heights[key] = height
+    }
+
+    // MARK: - Private Helpers
+    private func rebuild(from output: RecognizedOutput) {
+        var rebuilt: [ViewerFragment] = []
+        var rebuiltIndex: [UUID: Int] = [:]
+        rebuilt.reserveCapacity(output.segments.count)
+
+        for segment in output.segments {
+            guard let text = segment.text else { continue }
+            rebuiltIndex[segment.blockId] = rebuilt.count
+            rebuilt.append(ViewerFragment(blockId: segment.blockId, text: text))
+        }
+
+        let liveKeys = Set(rebuilt.map(\.key))
+        heights = heights.filter { liveKeys.contains($0.key) }
+        indexByBlockId = rebuiltIndex
+        fragments = rebuilt
+    }
+}
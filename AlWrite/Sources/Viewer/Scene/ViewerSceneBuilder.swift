@@ -5,6 +5,10 @@ import PencilKit
 @MainActor
 struct ViewerSceneBuilder {
     func build(viewStore: ViewStore<DocumentState, DocumentEvent>) -> UIViewController {
-        return UIHostingController(rootView: ViewerView(viewStore: viewStore))
+        let rootView = ViewerView(
+            recognizedOutput: viewStore.scope(\.recognizedOutput),
+            isRecognitionLoading: viewStore.scope(\.isRecognitionLoading)
+        )
+        return UIHostingController(rootView: rootView)
     }
 } 
\ No newline at end of file
@@ -0,0 +1,79 @@
+import XCTest
+@testable import AlWrite
+
+/// Entry point for the benchmarks that need the app, its engine or UIKit. Run the tests of the
+/// `AlWriteBenchmarks` scheme on a device or simulator and read the printed tables; the platform-neutral
+/// benchmarks live in the InkCore package and run with `swift run -c release InkCoreBenchmarks`.
+final class AlWriteBenchmarks: XCTestCase {
+    func testPointerEvents() throws {
+        let measurements: [PointerEventBenchmark.Measurement]
+        do {
+            measurements = try PointerEventBenchmark().run()
+        } catch PointerEventBenchmarkError.engineUnavailable(let message) {
+            throw XCTSkip("MyScript engine unavailable: \(message)")
+        }
+        measurements.forEach { print($0.summary) }
+    }
+
+    /// With a single worker every block stays in its session, so each one-stroke edit sends exactly one stroke.
+    @MainActor
+    func testSessionAffinity() async throws {
+        let rounds: [SessionAffinityBenchmark.Round]
+        do {
+            rounds = try await SessionAffinityBenchmark().run()
+        } catch SessionAffinityBenchmarkError.engineUnavailable(let message) {
+            throw XCTSkip("MyScript engine unavailable: \(message)")
+        }
+        rounds.forEach { print($0.summary) }
+
+        for round in rounds where round.workerCount == 1 && round.index > 0 {
+            XCTAssertEqual(round.sentStrokeCount, round.editCount, round.summary)
+        }
+    }
+
+    /// Also compiles against the reference implementation's canvas sources, which the app does not ship.
+    func testDisplayListReplay() throws {
+        let result = try XCTUnwrap(DisplayListBenchmark().run(), "Could not create the offscreen context")
+        XCTAssertGreaterThan(result.commandCount, 0)
+    }
+
+    func testGlyphMetricsCache() {
+        GlyphMetricsBenchmark().run()
+    }
+
+    @MainActor
+    func testViewStoreScopes() {
+        ViewStoreBenchmark().run().forEach { print($0.summary) }
+    }
+
+    /// Runs on the notebook `ALWRITE_REPLAY_NOTEBOOK` points to and needs the MyScript engine.
+    @MainActor
+    func testResamplingAccuracy() async throws {
+        let key = RecognitionReplayHarness.notebookEnvironmentKey
+        guard let notebookPath = ProcessInfo.processInfo.environment[key] else {
+            throw XCTSkip("Set \(key) to the path of an .alwrite notebook to recognize it")
+        }
+        let benchmark = ResamplingAccuracyBenchmark()
+        let rows: [ResamplingAccuracyBenchmark.Row]
+        do {
+            rows = try await benchmark.run(notebookAt: URL(fileURLWithPath: notebookPath))
+        } catch ResamplingAccuracyBenchmarkError.engineUnavailable(let message) {
+            throw XCTSkip("MyScript engine unavailable: \(message)")
+        }
+        rows.forEach { print($0.summary) }
+        if let row = benchmark.recommendation(from: rows) {
+            print("Fewest points with at least \(benchmark.requiredAgreement * 100)% agreement: \(row.setting)")
+        }
+    }
+
+    /// End-to-end replay of a recorded notebook; set `ALWRITE_REPLAY_NOTEBOOK` in the scheme to enable it.
+    @MainActor
+    func testRecognitionReplay() async throws {
+        let key = RecognitionReplayHarness.notebookEnvironmentKey
+        guard let notebookPath = ProcessInfo.processInfo.environment[key] else {
+            throw XCTSkip("Set \(key) to the path of an .alwrite notebook to replay it")
+        }
+        let report = try await RecognitionReplayHarness().replay(notebookAt: URL(fileURLWithPath: notebookPath))
+        print(report.summary)
+    }
+}
@@ -0,0 +1,118 @@
+// Copyright @ MyScript. All rights reserved.
+
+import Foundation
+import InkCore
+import InkFixtures
+import UIKit
+
+/// Headless comparison of issuing a page of canvas calls directly against replaying them from a DisplayList. It draws into an offscreen bitmap context, so it needs neither a window nor an engine; `AlWriteBenchmarks.testDisplayListReplay` prints the summary.
+/// The direct pass only covers the canvas calls; with a real renderer, walking the model comes on top of it, so the measured gain is a lower bound.
+
+class DisplayListBenchmark {
+
+    struct Result {
+        let commandCount:Int
+        let listByteCount:Int
+        let recordTime:TimeInterval
+        let directTime:TimeInterval
+        let replayTime:TimeInterval
+
+        var summary:String {
+            return String(format: "%d commands (%d KB): record %.2f ms, direct %.2f ms, replay %.2f ms per pass",
+                          self.commandCount, self.listByteCount / 1024, self.recordTime * 1000, self.directTime * 1000, self.replayTime * 1000)
+        }
+    }
+
+    // MARK: - Properties
+
+    var pageSize:CGSize = CGSize(width: 1024, height: 1366)
+    var strokeCount:Int = 1500
+    var segmentsPerStroke:Int = 24
+    var labelCount:Int = 200
+    var iterations:Int = 20
+
+    // MARK: - Run
+
+    @discardableResult
+    func run() -> Result? {
+        guard let context = CGContext(data: nil,
+                                      width: Int(self.pageSize.width),
+                                      height: Int(self.pageSize.height),
+                                      bitsPerComponent: 8,
+                                      bytesPerRow: 0,
+                                      space: CGColorSpaceCreateDeviceRGB(),
+                                      bitmapInfo: CGImageAlphaInfo.premultipliedLast.rawValue) else {
+            return nil
+        }
+        let canvas:Canvas = Canvas()
+        canvas.context = context
+        canvas.size = self.pageSize
+
+        let strokes:InkDrawing = SyntheticInk.drawing(strokeCount: self.strokeCount, pointsPerStroke: self.segmentsPerStroke + 1)
+        let list:DisplayList = DisplayList()
+        let recordTime:TimeInterval = self.measure {
+            list.reset()
+            self.drawPage(strokes, on: RecordingCanvas(list: list, size: self.pageSize))
+        }
+        let directTime:TimeInterval = self.measure {
+            self.drawPage(strokes, on: canvas)
+        }
+        let replayTime:TimeInterval = self.measure {
+            list.replay(on: canvas)
+        }
+
+        let result = Result(commandCount: list.opcodes.count,
+                            listByteCount: list.byteCount,
+                            recordTime: recordTime,
+                            directTime: directTime,
+                            replayTime: replayTime)
+        print("DisplayListBenchmark: \(result.summary)")
+        return result
+    }
+
+    // MARK: - Private Helpers
+
+    /// Median duration of one pass, after a warm-up pass.
+    private func measure(_ pass:() -> Void) -> TimeInterval {
+        pass()
+        var durations:[TimeInterval] = []
+        durations.reserveCapacity(self.iterations)
+        for _ in 0..<self.iterations {
+            let start:CFAbsoluteTime = CFAbsoluteTimeGetCurrent()
+            pass()
+            durations.append(CFAbsoluteTimeGetCurrent() - start)
+        }
+        durations.sort()
+        return durations[durations.count / 2]
+    }
+
+    /// A page of the shared handwriting fixture, smoothed into quadratic segments through the sample midpoints, and a few text labels. Every pass issues the same calls.
+    private func drawPage(_ strokes:InkDrawing, on canvas:IINKICanvas) {
+        canvas.startDraw(in: CGRect(origin: .zero, size: self.pageSize))
+        canvas.setTransform(.identity)
+        canvas.setFillColor(0x000000ff)
+        canvas.setStrokeColor(0x00000000)
+        for stroke in strokes.strokes {
+            let samples:StrokeSampleBuffer = stroke.samples
+            guard samples.count > 1 else {
+                continue
+            }
+            let path:IINKIPath = canvas.createPath()
+            path.move(to: CGPoint(x: CGFloat(samples.x[0]), y: CGFloat(samples.y[0])))
+            for index in 1..<samples.count {
+                let control = CGPoint(x: CGFloat(samples.x[index - 1]), y: CGFloat(samples.y[index - 1]))
+                let next = CGPoint(x: (CGFloat(samples.x[index - 1]) + CGFloat(samples.x[index])) / 2,
+                                   y: (CGFloat(samples.y[index - 1]) + CGFloat(samples.y[index])) / 2)
+                path.quad(to: next, controlPoint: control)
+            }
+            path.close()
+            canvas.draw(path)
+        }
+        canvas.setFontProperties("Helvetica", height: 24, size: 18, style: "normal", variant: "normal", weight: 400)
+        for labelIndex in 0..<self.labelCount {
+            let anchor = CGPoint(x: CGFloat(labelIndex % 10) * 100, y: CGFloat(labelIndex / 10) * 60 + 40)
+            canvas.drawText("label \(labelIndex)", anchor: anchor, region: CGRect(x: anchor.x, y: anchor.y - 18, width: 90, height: 24))
+        }
+        canvas.endDraw()
+    }
+}
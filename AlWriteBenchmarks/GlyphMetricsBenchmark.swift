@@ -0,0 +1,92 @@
+// Copyright @ MyScript. All rights reserved.
+
+import Foundation
+import InkFixtures
+import UIKit
+
+/// Headless measure of the glyph metrics path on layout-heavy text: the labels of a few long documents are measured over several reflow passes, once with the GlyphMetricsCache and once with it disabled. `AlWriteBenchmarks.testGlyphMetricsCache` prints the summary; no engine is needed, so the labels are styled here the way the engine styles its spans.
+
+class GlyphMetricsBenchmark {
+
+    struct Result {
+        let cached:GlyphMetricsCache.Statistics
+        let uncached:GlyphMetricsCache.Statistics
+
+        var summary:String {
+            return String(format: "%d calls: cached %.1f µs per call (line hit rate %.1f%%, glyph hit rate %.1f%%, %d of %d runs fully cached), uncached %.1f µs per call",
+                          self.cached.calls, self.cached.timePerCall * 1_000_000, self.cached.lineHitRate * 100, self.cached.hitRate * 100, self.cached.cachedRuns, self.cached.totalRuns, self.uncached.timePerCall * 1_000_000)
+        }
+    }
+
+    // MARK: - Properties
+
+    var documentCount:Int = 4
+    var paragraphsPerDocument:Int = 40
+    var wordsPerParagraph:Int = 60
+    /// Each pass measures every label again, as the engine does when the layout changes.
+    var reflowPasses:Int = 10
+
+    // MARK: - Run
+
+    @discardableResult
+    func run() -> Result {
+        let labels:[NSAttributedString] = self.makeLabels()
+        let cached:GlyphMetricsCache.Statistics = self.measure(labels, cache: GlyphMetricsCache())
+        let uncachedCache:GlyphMetricsCache = GlyphMetricsCache()
+        uncachedCache.isEnabled = false
+        let uncached:GlyphMetricsCache.Statistics = self.measure(labels, cache: uncachedCache)
+
+        let result = Result(cached: cached, uncached: uncached)
+        print("GlyphMetricsBenchmark: \(result.summary)")
+        return result
+    }
+
+    // MARK: - Private Helpers
+
+    private func measure(_ labels:[NSAttributedString], cache:GlyphMetricsCache) -> GlyphMetricsCache.Statistics {
+        var glyphCount:Int = 0
+        for _ in 0..<self.reflowPasses {
+            for label in labels {
+                glyphCount += cache.metrics(for: label).count
+            }
+        }
+        precondition(glyphCount > 0, "No glyph was measured")
+        return cache.statistics
+    }
+
+    /// Paragraphs of pseudo-words from a fixed sequence, split into lines of a dozen words, with a heading style, a body style and an emphasized span per line.
+    private func makeLabels() -> [NSAttributedString] {
+        let syllables:[String] = ["ka", "lo", "mi", "ne", "tur", "sa", "ve", "dor", "pi", "qua", "ré", "zen", "ho", "ly", "ß", "ça"]
+        let heading:FontStyle = FontStyleTable.shared.style(for: FontStyleKey(family: "sans-serif", size: 24, weight: 700, style: "normal", variant: "normal", lineHeight: 32))
+        let body:FontStyle = FontStyleTable.shared.style(for: FontStyleKey(family: "sans-serif", size: 16, weight: 400, style: "normal", variant: "normal", lineHeight: 22))
+        let emphasis:FontStyle = FontStyleTable.shared.style(for: FontStyleKey(family: "sans-serif", size: 16, weight: 400, style: "italic", variant: "normal", lineHeight: 22))
+
+        var generator = SeededGenerator(seed: 42)
+        func next(_ bound:Int) -> Int {
+            return Int.random(in: 0..<bound, using: &generator)
+        }
+        func word() -> String {
+            return (0..<(1 + next(3))).map { _ in syllables[next(syllables.count)] }.joined()
+        }
+
+        var labels:[NSAttributedString] = []
+        for _ in 0..<self.documentCount {
+            for paragraph in 0..<self.paragraphsPerDocument {
+                if paragraph % 10 == 0 {
+                    labels.append(NSAttributedString(string: (0..<4).map { _ in word() }.joined(separator: " "), attributes: heading.attributes))
+                }
+                var words:[String] = (0..<self.wordsPerParagraph).map { _ in word() }
+                while !words.isEmpty {
+                    let lineWords:[String] = Array(words.prefix(12))
+                    words.removeFirst(lineWords.count)
+                    let line = NSMutableAttributedString(string: lineWords.joined(separator: " "), attributes: body.attributes)
+                    let emphasized:String = lineWords[next(lineWords.count)]
+                    let range:NSRange = (line.string as NSString).range(of: emphasized)
+                    line.setAttributes(emphasis.attributes, range: range)
+                    labels.append(line)
+                }
+            }
+        }
+        return labels
+    }
+}
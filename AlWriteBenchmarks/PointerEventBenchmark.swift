@@ -0,0 +1,117 @@
+import Foundation
+import InkCore
+import InkFixtures
+import PencilKit
+import MyScriptInteractiveInk_Runtime
+@testable import AlWrite
+
+enum PointerEventBenchmarkError: Error, Equatable {
+    case engineUnavailable(String)
+}
+
+/// Times sending drawings to a headless recognizer one pointer call per point, as the converter used to,
+/// against one `pointerEvents` call per drawing, for growing stroke counts.
+///
+/// Needs the MyScript engine but no UI; `AlWriteBenchmarks.testPointerEvents` prints the table.
+final class PointerEventBenchmark {
+    struct Measurement {
+        let strokeCount: Int
+        let eventCount: Int
+        /// Median time to build the event buffer from the strokes, paid by both paths.
+        let conversion: TimeInterval
+        let perPoint: TimeInterval
+        let batched: TimeInterval
+
+        var summary: String {
+            String(
+                format: "%4d strokes, %6d events: convert %7.2f ms, per point %8.2f ms, batched %7.2f ms (%.1fx)",
+                strokeCount, eventCount, conversion * 1000, perPoint * 1000, batched * 1000,
+                batched > 0 ? perPoint / batched : 0
+            )
+        }
+    }
+
+    private static let millimetersPerUnit: Float = 25.4 / 96
+
+    var strokeCounts = [1, 10, 100, 500]
+    /// Before the converter's 1 pt interpolation, which adds points on fast strokes.
+    var pointsPerStroke = 120
+    var iterations = 7
+
+    func run() throws -> [Measurement] {
+        guard let engine = EngineProvider.sharedInstance.engine else {
+            throw PointerEventBenchmarkError.engineUnavailable(EngineProvider.sharedInstance.engineErrorMessage)
+        }
+        let scale = Self.millimetersPerUnit
+        let recognizer = try engine.createRecognizer(scaleX: scale, scaleY: scale, type: StandardRecognitionMode.text.partType)
+
+        return try strokeCounts.map { strokeCount in
+            try measure(makeStrokes(count: strokeCount), with: recognizer)
+        }
+    }
+
+    // MARK: - Private Helpers
+    private func measure(_ strokes: [PKStroke], with recognizer: IINKRecognizer) throws -> Measurement {
+        var events: [IINKPointerEvent] = []
+        var conversions: [TimeInterval] = []
+        var perPointDurations: [TimeInterval] = []
+        var batchedDurations: [TimeInterval] = []
+
+        for _ in 0..<iterations {
+            conversions.append(time {
+                events = PencilKitToMyScriptConverter.pointerEvents(for: strokes)
+            })
+
+            try recognizer.clear()
+            perPointDurations.append(try time {
+                try submitPerPoint(events, to: recognizer)
+            })
+
+            try recognizer.clear()
+            batchedDurations.append(try time {
+                try recognizer.pointerEvents(&events, count: events.count)
+            })
+        }
+        try recognizer.clear()
+
+        return Measurement(
+            strokeCount: strokes.count,
+            eventCount: events.count,
+            conversion: median(of: conversions),
+            perPoint: median(of: perPointDurations),
+            batched: median(of: batchedDurations)
+        )
+    }
+
+    private func submitPerPoint(_ events: [IINKPointerEvent], to recognizer: IINKRecognizer) throws {
+        for event in events {
+            let point = CGPoint(x: CGFloat(event.x), y: CGFloat(event.y))
+            switch event.eventType {
+            case .down:
+                _ = try recognizer.pointerDown(point: point, timestamp: event.t, force: event.f)
+            case .move:
+                try recognizer.pointerMove(point: point, timestamp: event.t, force: event.f)
+            case .up:
+                try recognizer.pointerUp(point: point, timestamp: event.t, force: event.f)
+            default:
+                break
+            }
+        }
+    }
+
+    /// Handwriting-like strokes from the shared fixture, laid out in lines and sampled at 120 Hz.
+    private func makeStrokes(count: Int) -> [PKStroke] {
+        let drawing = SyntheticInk.drawing(strokeCount: count, pointsPerStroke: pointsPerStroke)
+        return PKDrawing(drawing, ink: PKInk(.pen, color: .black), pointSize: CGSize(width: 2, height: 2)).strokes
+    }
+
+    private func time(_ body: () throws -> Void) rethrows -> TimeInterval {
+        let start = ProcessInfo.processInfo.systemUptime
+        try body()
+        return ProcessInfo.processInfo.systemUptime - start
+    }
+
+    private func median(of samples: [TimeInterval]) -> TimeInterval {
+        samples.sorted()[samples.count / 2]
+    }
+}
@@ -0,0 +1,164 @@
+import Foundation
+import InkCore
+import PencilKit
+import MyScriptInteractiveInk_Runtime
+@testable import AlWrite
+
+enum ResamplingAccuracyBenchmarkError: Error, Equatable {
+    case engineUnavailable(String)
+    case noInk
+}
+
+/// Recognizes every block of a recorded notebook through the MyScript engine once per resampler setting and
+/// compares the text with what the unresampled strokes give, next to the points sent and the time taken.
+///
+/// `AlWriteBenchmarks.testResamplingAccuracy` prints the table for the notebook `ALWRITE_REPLAY_NOTEBOOK`
+/// points to, along with the setting that sends the fewest points while keeping `requiredAgreement`.
+@MainActor
+final class ResamplingAccuracyBenchmark {
+    struct Setting {
+        let name: String
+        let resampler: StrokeResampler
+
+        static let passthrough = Setting(name: "passthrough", resampler: PassthroughResampler())
+
+        static func douglasPeucker(tolerance: Float, maxPointsPerStroke: Int) -> Setting {
+            Setting(
+                name: String(format: "rdp %.2f/%d", tolerance, maxPointsPerStroke),
+                resampler: DouglasPeuckerResampler(tolerance: tolerance, maxPointsPerStroke: maxPointsPerStroke)
+            )
+        }
+    }
+
+    struct Row {
+        let setting: String
+        let pointCount: Int
+        let referencePointCount: Int
+        /// Blocks whose text is identical to the passthrough text.
+        let exactMatches: Int
+        let blockCount: Int
+        /// One minus the edit distance over the longer text, summed over all blocks.
+        let agreement: Double
+        /// Median over iterations of the time to recognize every block.
+        let duration: TimeInterval
+
+        var summary: String {
+            String(
+                format: "%@: %8d points (%5.1f%%), %3d/%d blocks identical, agreement %6.2f%%, %8.1f ms",
+                setting, pointCount, Double(pointCount) / Double(max(referencePointCount, 1)) * 100,
+                exactMatches, blockCount, agreement * 100, duration * 1000
+            )
+        }
+    }
+
+    private struct Pass {
+        let texts: [String]
+        let duration: TimeInterval
+    }
+
+    var settings: [Setting] = [
+        .douglasPeucker(tolerance: 0.25, maxPointsPerStroke: 256),
+        .douglasPeucker(tolerance: 0.5, maxPointsPerStroke: 256),
+        .douglasPeucker(tolerance: 1, maxPointsPerStroke: 256),
+        .douglasPeucker(tolerance: 2, maxPointsPerStroke: 256),
+        .douglasPeucker(tolerance: 0.5, maxPointsPerStroke: 64),
+        .douglasPeucker(tolerance: 0.5, maxPointsPerStroke: 32)
+    ]
+    var requiredAgreement = 0.995
+    var iterations = 3
+
+    /// The passthrough row comes first, the other settings follow in order.
+    func run(notebookAt url: URL) async throws -> [Row] {
+        guard let engine = EngineProvider.sharedInstance.engine else {
+            throw ResamplingAccuracyBenchmarkError.engineUnavailable(EngineProvider.sharedInstance.engineErrorMessage)
+        }
+        let blocks = try await RecognitionReplayHarness.recordedBlocks(ofNotebookAt: url)
+            .filter { !$0.drawing.strokes.isEmpty }
+        guard !blocks.isEmpty else {
+            throw ResamplingAccuracyBenchmarkError.noInk
+        }
+
+        let reference = try await recognize(blocks, with: .passthrough, engine: engine)
+        let referencePointCount = pointCount(of: blocks, with: .passthrough)
+
+        var rows = [Row(
+            setting: Setting.passthrough.name,
+            pointCount: referencePointCount,
+            referencePointCount: referencePointCount,
+            exactMatches: blocks.count,
+            blockCount: blocks.count,
+            agreement: 1,
+            duration: reference.duration
+        )]
+        for setting in settings {
+            let pass = try await recognize(blocks, with: setting, engine: engine)
+            let pairs = zip(reference.texts, pass.texts)
+            let distance = pairs.reduce(0) { $0 + editDistance($1.0, $1.1) }
+            let length = pairs.reduce(0) { $0 + max($1.0.count, $1.1.count) }
+            rows.append(Row(
+                setting: setting.name,
+                pointCount: pointCount(of: blocks, with: setting),
+                referencePointCount: referencePointCount,
+                exactMatches: pairs.filter { $0.0 == $0.1 }.count,
+                blockCount: blocks.count,
+                agreement: length > 0 ? 1 - Double(distance) / Double(length) : 1,
+                duration: pass.duration
+            ))
+        }
+        return rows
+    }
+
+    /// The row with the fewest points that still reaches `requiredAgreement`.
+    func recommendation(from rows: [Row]) -> Row? {
+        rows.filter { $0.agreement >= requiredAgreement }.min { $0.pointCount < $1.pointCount }
+    }
+
+    // MARK: - Private Helpers
+    /// Fresh sessions for every iteration, so no block is answered from strokes a previous pass left behind.
+    private func recognize(_ blocks: [DrawingBlock], with setting: Setting, engine: IINKEngine) async throws -> Pass {
+        var texts: [String] = []
+        var durations: [TimeInterval] = []
+
+        for _ in 0..<iterations {
+            var sessions: [StandardRecognitionMode: MyScriptRecognitionSession] = [:]
+            for mode in StandardRecognitionMode.allCases {
+                sessions[mode] = try MyScriptRecognitionSession(engine: engine, mode: mode, resampler: setting.resampler)
+            }
+
+            texts.removeAll()
+            let start = ProcessInfo.processInfo.systemUptime
+            for block in blocks {
+                let mode: StandardRecognitionMode = (block.type == .math) ? .math : .text
+                texts.append(try await sessions[mode]!.process(block.drawing, blockId: block.id))
+            }
+            durations.append(ProcessInfo.processInfo.systemUptime - start)
+        }
+
+        return Pass(texts: texts, duration: durations.sorted()[durations.count / 2])
+    }
+
+    private func pointCount(of blocks: [DrawingBlock], with setting: Setting) -> Int {
+        blocks.reduce(0) { total, block in
+            block.drawing.strokes.reduce(total) { total, stroke in
+                total + setting.resampler.resample(PencilKitToMyScriptConverter.samples(of: stroke)).count
+            }
+        }
+    }
+
+    private func editDistance(_ lhs: String, _ rhs: String) -> Int {
+        let lhs = Array(lhs)
+        let rhs = Array(rhs)
+        var previous = Array(0...rhs.count)
+        var current = previous
+
+        for i in lhs.indices {
+            current[0] = i + 1
+            for j in rhs.indices {
+                let substitution = previous[j] + (lhs[i] == rhs[j] ? 0 : 1)
+                current[j + 1] = min(substitution, previous[j + 1] + 1, current[j] + 1)
+            }
+            swap(&previous, &current)
+        }
+        return previous[rhs.count]
+    }
+}
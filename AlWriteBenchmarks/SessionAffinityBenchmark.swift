@@ -0,0 +1,119 @@
+import Foundation
+import InkCore
+import InkFixtures
+import PencilKit
+import MyScriptInteractiveInk_Runtime
+@testable import AlWrite
+
+enum SessionAffinityBenchmarkError: Error, Equatable {
+    case engineUnavailable(String)
+}
+
+/// Edits several blocks at once, one new stroke per block and round, through a recognition pool with fewer
+/// workers than blocks, and counts the strokes the sessions send to the engine. Once every block has been
+/// fed, a round should send one stroke per edit; a session that kept only its last block would send every
+/// stroke of the block again.
+///
+/// Needs the MyScript engine but no UI; `AlWriteBenchmarks.testSessionAffinity` prints the table.
+@MainActor
+final class SessionAffinityBenchmark {
+    struct Round {
+        let workerCount: Int
+        let index: Int
+        let editCount: Int
+        let sentStrokeCount: Int
+        let duration: TimeInterval
+
+        var summary: String {
+            String(
+                format: "%d workers, round %2d: %2d edits, %4d strokes sent (%.2f per edit), %7.2f ms",
+                workerCount, index, editCount, sentStrokeCount,
+                Double(sentStrokeCount) / Double(editCount), duration * 1000
+            )
+        }
+    }
+
+    @MainActor
+    private final class SessionLog {
+        var sessions: [MyScriptRecognitionSession] = []
+
+        func append(_ session: MyScriptRecognitionSession) {
+            sessions.append(session)
+        }
+    }
+
+    var workerCounts = [1, 2]
+    /// Within what one worker's text session keeps, so any worker can end up holding every block.
+    var blockCount = RecognitionSessionLimits.heldBlocks
+    var initialStrokeCount = 40
+    var roundCount = 8
+
+    func run() async throws -> [Round] {
+        guard let engine = EngineProvider.sharedInstance.engine else {
+            throw SessionAffinityBenchmarkError.engineUnavailable(EngineProvider.sharedInstance.engineErrorMessage)
+        }
+
+        var rounds: [Round] = []
+        for workerCount in workerCounts {
+            rounds += try await measure(workerCount: workerCount, engine: engine)
+        }
+        return rounds
+    }
+
+    // MARK: - Private Helpers
+    private func measure(workerCount: Int, engine: IINKEngine) async throws -> [Round] {
+        let log = SessionLog()
+        let pool = RecognitionWorkerPool(size: workerCount) { mode in
+            let session = try MyScriptRecognitionSession(engine: engine, mode: mode)
+            await log.append(session)
+            return session
+        }
+
+        let ink = PKInk(.pen, color: .black)
+        let blocks = (0..<blockCount).map { index in
+            let drawing = SyntheticInk.drawing(
+                strokeCount: initialStrokeCount + roundCount,
+                pointsPerStroke: 60,
+                seed: UInt64(index + 1)
+            )
+            return (id: UUID(), strokes: PKDrawing(drawing, ink: ink, pointSize: CGSize(width: 2, height: 2)).strokes)
+        }
+
+        // Round 0 feeds every block; each later round adds one stroke to each of them.
+        var rounds: [Round] = []
+        for index in 0...roundCount {
+            let sentBefore = await sentStrokeCount(of: log.sessions)
+            let start = ProcessInfo.processInfo.systemUptime
+            try await withThrowingTaskGroup(of: String.self) { group in
+                for block in blocks {
+                    let job = RecognitionJob(
+                        blockId: block.id,
+                        blockVersion: UInt64(index),
+                        mode: .text,
+                        drawing: PKDrawing(strokes: Array(block.strokes.prefix(initialStrokeCount + index)))
+                    )
+                    group.addTask { try await pool.run(job) }
+                }
+                try await group.waitForAll()
+            }
+            let duration = ProcessInfo.processInfo.systemUptime - start
+
+            rounds.append(Round(
+                workerCount: workerCount,
+                index: index,
+                editCount: blocks.count,
+                sentStrokeCount: await sentStrokeCount(of: log.sessions) - sentBefore,
+                duration: duration
+            ))
+        }
+        return rounds
+    }
+
+    private func sentStrokeCount(of sessions: [MyScriptRecognitionSession]) async -> Int {
+        var total = 0
+        for session in sessions {
+            total += await session.sentStrokeCount
+        }
+        return total
+    }
+}
@@ -0,0 +1,127 @@
+import Combine
+import Foundation
+import InkCore
+import InkFixtures
+import PencilKit
+@testable import AlWrite
+
+/// Counts how often each view store slice is recomputed and re-emitted per document event, on a document of
+/// many blocks, next to the full view state that observers of the whole `DocumentState` would receive.
+///
+/// Needs no UI and no MyScript assets; `AlWriteBenchmarks.testViewStoreScopes` prints the table.
+@MainActor
+final class ViewStoreBenchmark {
+    struct Row {
+        let event: String
+        let count: Int
+        let duration: TimeInterval
+        let stateEmissions: Int
+        /// Per scope name: slice reads and the changes that got through.
+        let scopes: [(name: String, evaluations: Int, emissions: Int)]
+
+        var summary: String {
+            let perEvent = Double(count)
+            let scopeColumns = scopes
+                .map { String(format: "%@ %.2f/%.2f", $0.name, Double($0.evaluations) / perEvent, Double($0.emissions) / perEvent) }
+                .joined(separator: ", ")
+            return String(
+                format: "%@: %.1f µs per event, state emissions %.2f; evaluations/emissions per event: %@",
+                event, duration / perEvent * 1_000_000, Double(stateEmissions) / perEvent, scopeColumns
+            )
+        }
+    }
+
+    private struct ScopeCounter {
+        let name: String
+        let evaluationCount: () -> Int
+        let emissionCount: () -> Int
+    }
+
+    var blockCount = 1_000
+    var eventsPerKind = 200
+
+    func run() -> [Row] {
+        let cacheDirectory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("ViewStoreBenchmark-\(UUID().uuidString)", isDirectory: true)
+        defer { try? FileManager.default.removeItem(at: cacheDirectory) }
+
+        let recognitionManager = HandwritingRecognitionManager(
+            engine: FakeRecognitionEngine(),
+            resultCache: RecognitionResultCache(directory: cacheDirectory)
+        )
+        let store = DocumentStore(
+            router: BenchmarkDocumentRouter(),
+            dependenciesContainer: DocumentDependenciesContainer(recognitionManager: recognitionManager),
+            document: nil
+        )
+        let viewStore = ViewStore<DocumentState, DocumentEvent>(store)
+
+        // Already recognized, so loading does not start recognition work that would land mid-measurement.
+        let blocks = (0..<blockCount).map { index in
+            DrawingBlock(id: UUID(), type: index % 5 == 0 ? .math : .text, recognizedText: "Block \(index)", isModified: false)
+        }
+        store.handle(.documentLoaded(blocks: BlockList(blocks)))
+
+        var stateEmissions = 0
+        let subscription = viewStore.$state.dropFirst().sink { _ in
+            stateEmissions += 1
+        }
+        defer { subscription.cancel() }
+
+        let counters = [
+            counter("blocks", viewStore.scope(\.blocks)),
+            counter("output", viewStore.scope(\.recognizedOutput)),
+            counter("toolPicker", viewStore.scope(\.isToolPickerVisible)),
+            counter("viewer", viewStore.scope(\.isViewerVisible)),
+            counter("loading", viewStore.scope(\.isRecognitionLoading))
+        ]
+
+        let editedBlockId = blocks[blocks.count / 2].id
+        // One to eight short strokes, so every edit changes the drawing.
+        let drawings = (1...8).map { strokeCount in
+            PKDrawing(SyntheticInk.drawing(strokeCount: strokeCount, pointsPerStroke: 12), ink: PKInk(.pen, color: .black))
+        }
+
+        let proportions: [DocumentState.ViewerProportionState] = [.third, .half]
+        let eventKinds: [(name: String, makeEvent: (Int) -> DocumentEvent)] = [
+            ("toggleToolPicker", { _ in .toggleToolPicker }),
+            ("changeViewerProportion", { index in .changeViewerProportion(proportions[index % proportions.count]) }),
+            ("updateBlockDrawing", { index in
+                .updateBlockDrawing(id: editedBlockId, drawing: drawings[index % drawings.count])
+            })
+        ]
+
+        return eventKinds.map { kind in
+            let stateEmissionsBefore = stateEmissions
+            let countsBefore = counters.map { ($0.evaluationCount(), $0.emissionCount()) }
+            let start = ProcessInfo.processInfo.systemUptime
+            for index in 0..<eventsPerKind {
+                store.handle(kind.makeEvent(index))
+            }
+            let duration = ProcessInfo.processInfo.systemUptime - start
+
+            return Row(
+                event: kind.name,
+                count: eventsPerKind,
+                duration: duration,
+                stateEmissions: stateEmissions - stateEmissionsBefore,
+                scopes: zip(counters, countsBefore).map { counter, before in
+                    (counter.name, counter.evaluationCount() - before.0, counter.emissionCount() - before.1)
+                }
+            )
+        }
+    }
+
+    // MARK: - Private Helpers
+    private func counter<Value>(_ name: String, _ scope: ViewStoreScope<Value>) -> ScopeCounter {
+        ScopeCounter(
+            name: name,
+            evaluationCount: { scope.evaluationCount },
+            emissionCount: { scope.emissionCount }
+        )
+    }
+}
+
+private final class BenchmarkDocumentRouter: DocumentRouting {
+    func showDocumentViewController() {}
+}
@@ -0,0 +1,26 @@
+// swift-tools-version:5.9
+import PackageDescription
+
+// Platform-neutral stroke handling, document container, recognized text assembly and recognition
+// scheduling, debouncing and cache keys shared by the app.
+// Builds on Linux, where the tests run with `swift test` and the benchmarks with
+// `swift run -c release InkCoreBenchmarks`.
+let package = Package(
+    name: "InkCore",
+    platforms: [
+        .iOS(.v17),
+        .macOS(.v13)
+    ],
+    products: [
+        .library(name: "InkCore", targets: ["InkCore"]),
+        .library(name: "InkFixtures", targets: ["InkFixtures"])
+    ],
+    targets: [
+        .target(name: "InkCore"),
+        // Seeded generated handwriting, shared with the app's benchmark target.
+        .target(name: "InkFixtures", dependencies: ["InkCore"]),
+        .executableTarget(name: "InkCoreBenchmarks", dependencies: ["InkCore", "InkFixtures"]),
+        .testTarget(name: "InkCoreTests", dependencies: ["InkCore"])
+    ],
+    swiftLanguageVersions: [.v5]
+)
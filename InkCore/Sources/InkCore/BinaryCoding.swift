@@ -0,0 +1,87 @@
+import Foundation
+
+public enum BinaryCodingError: Error, Equatable {
+    case truncated
+}
+
+public struct BinaryWriter {
+    public private(set) var data: Data
+
+    public init(capacity: Int = 0) {
+        data = Data(capacity: capacity)
+    }
+
+    public mutating func write<T: FixedWidthInteger>(_ value: T) {
+        withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+    }
+
+    public mutating func write(_ uuid: UUID) {
+        withUnsafeBytes(of: uuid.uuid) { data.append(contentsOf: $0) }
+    }
+
+    public mutating func write(_ bytes: Data) {
+        data.append(bytes)
+    }
+
+    public mutating func write(_ bytes: [UInt8]) {
+        data.append(contentsOf: bytes)
+    }
+}
+
+public struct BinaryReader {
+    private let data: Data
+    public private(set) var offset: Data.Index
+
+    public init(_ data: Data) {
+        self.data = data
+        self.offset = data.startIndex
+    }
+
+    public var remaining: Int {
+        data.endIndex - offset
+    }
+
+    public mutating func read<T: FixedWidthInteger>(_ type: T.Type) throws -> T {
+        let size = MemoryLayout<T>.size
+        let bytes = try readBytes(count: size)
+        let value = bytes.withUnsafeBytes { $0.loadUnaligned(as: T.self) }
+        return T(littleEndian: value)
+    }
+
+    public mutating func readUUID() throws -> UUID {
+        let bytes = try readBytes(count: MemoryLayout<uuid_t>.size)
+        return UUID(uuid: bytes.withUnsafeBytes { $0.loadUnaligned(as: uuid_t.self) })
+    }
+
+    /// Returns a slice sharing storage with the underlying data, so large payloads are not copied.
+    public mutating func readBytes(count: Int) throws -> Data {
+        guard count >= 0, remaining >= count else {
+            throw BinaryCodingError.truncated
+        }
+        let bytes = data[offset..<offset + count]
+        offset += count
+        return bytes
+    }
+}
+
+public enum CRC32 {
+    private static let table: [UInt32] = (0..<256).map { index in
+        var value = UInt32(index)
+        for _ in 0..<8 {
+            value = (value & 1) != 0 ? 0xEDB8_8320 ^ (value >> 1) : value >> 1
+        }
+        return value
+    }
+
+    public static func checksum(_ data: Data) -> UInt32 {
+        var crc: UInt32 = 0xFFFF_FFFF
+        table.withUnsafeBufferPointer { table in
+            data.withUnsafeBytes { buffer in
+                for byte in buffer {
+                    crc = table[Int((crc ^ UInt32(byte)) & 0xFF)] ^ (crc >> 8)
+                }
+            }
+        }
+        return crc ^ 0xFFFF_FFFF
+    }
+}
@@ -0,0 +1,47 @@
+import Foundation
+
+/// 64-bit FNV-1a. Unlike `Hasher` it is stable across launches, so it can name on-disk entries.
+public struct FNV1aHasher {
+    public private(set) var value: UInt64 = 0xCBF2_9CE4_8422_2325
+
+    public init() {}
+
+    public mutating func combine<T: FixedWidthInteger>(_ integer: T) {
+        withUnsafeBytes(of: integer.littleEndian) { bytes in
+            for byte in bytes {
+                value ^= UInt64(byte)
+                value &*= 0x0000_0100_0000_01B3
+            }
+        }
+    }
+
+    public mutating func combine(_ string: String) {
+        for byte in string.utf8 {
+            combine(byte)
+        }
+        combine(UInt8(0))
+    }
+}
+
+/// Hash of ink geometry: per stroke its point count and the points quantized to 1/8 of a point.
+/// Timestamps, ink and force are left out, so undo/redo and copies of a drawing hash the same as the original.
+public struct InkContentHasher {
+    public static let quantization: Double = 8
+
+    private var hasher = FNV1aHasher()
+
+    public init() {}
+
+    public var value: UInt64 {
+        hasher.value
+    }
+
+    public mutating func beginStroke(pointCount: Int) {
+        hasher.combine(UInt32(pointCount))
+    }
+
+    public mutating func combinePoint(x: Double, y: Double) {
+        hasher.combine(Int32(clamping: Int((x * Self.quantization).rounded())))
+        hasher.combine(Int32(clamping: Int((y * Self.quantization).rounded())))
+    }
+}
@@ -0,0 +1,179 @@
+import Foundation
+
+public enum DocumentFormatError: Error, Equatable {
+    case notAContainer
+    case unsupportedVersion(UInt16)
+    case truncated
+    case corruptedIndex
+    case checksumMismatch(blockId: UUID)
+    case missingChunk(blockId: UUID)
+    case invalidBlockType(UInt8)
+}
+
+/// Stroke payload of a single block, stored as its own chunk of the container.
+public struct DocumentChunk: Equatable {
+    public let data: Data
+    public let checksum: UInt32
+
+    public init(data: Data) {
+        self.data = data
+        self.checksum = CRC32.checksum(data)
+    }
+
+    public init(data: Data, checksum: UInt32) {
+        self.data = data
+        self.checksum = checksum
+    }
+
+    public func validated(blockId: UUID) throws -> Data {
+        guard CRC32.checksum(data) == checksum else {
+            throw DocumentFormatError.checksumMismatch(blockId: blockId)
+        }
+        return data
+    }
+}
+
+/// Index entry of one block. The block type is stored as the app's raw code; the container does not interpret it.
+public struct DocumentBlockRecord {
+    public let id: UUID
+    public var typeCode: UInt8
+    public var recognizedText: String?
+    public var isModified: Bool
+    public var chunk: DocumentChunk
+
+    public init(id: UUID, typeCode: UInt8, recognizedText: String?, isModified: Bool, chunk: DocumentChunk) {
+        self.id = id
+        self.typeCode = typeCode
+        self.recognizedText = recognizedText
+        self.isModified = isModified
+        self.chunk = chunk
+    }
+}
+
+/// Versioned binary container with one chunk per block.
+///
+/// Layout (little-endian):
+/// - header: magic `ALWD`, format version (UInt16), reserved (UInt16), block count (UInt32),
+///   index length (UInt32), index checksum (UInt32);
+/// - index: per block its id, type, flags, recognized text, and the offset, length and checksum of its chunk;
+/// - chunk area: concatenated stroke payloads, offsets relative to its start.
+public enum DocumentContainer {
+    public static let magic: [UInt8] = Array("ALWD".utf8)
+    public static let currentVersion: UInt16 = 1
+
+    private static let headerSize = 20
+    /// Id, type, flags, text length, offset, length and checksum of a record with empty text.
+    private static let minimumRecordSize = 16 + 1 + 1 + 4 + 8 + 4 + 4
+
+    private enum Flag {
+        static let isModified: UInt8 = 1 << 0
+        static let hasRecognizedText: UInt8 = 1 << 1
+    }
+
+    public static func isContainer(_ data: Data) -> Bool {
+        data.count >= magic.count && data.prefix(magic.count).elementsEqual(magic)
+    }
+
+    public static func encode(_ records: [DocumentBlockRecord]) -> Data {
+        var index = BinaryWriter()
+        var chunkOffset: UInt64 = 0
+
+        for record in records {
+            var flags: UInt8 = 0
+            if record.isModified { flags |= Flag.isModified }
+            let text = record.recognizedText.map { Data($0.utf8) }
+            if text != nil { flags |= Flag.hasRecognizedText }
+
+            index.write(record.id)
+            index.write(record.typeCode)
+            index.write(flags)
+            index.write(UInt32(text?.count ?? 0))
+            if let text { index.write(text) }
+            index.write(chunkOffset)
+            index.write(UInt32(record.chunk.data.count))
+            index.write(record.chunk.checksum)
+
+            chunkOffset += UInt64(record.chunk.data.count)
+        }
+
+        var writer = BinaryWriter(capacity: headerSize + index.data.count + Int(chunkOffset))
+        writer.write(magic)
+        writer.write(currentVersion)
+        writer.write(UInt16(0))
+        writer.write(UInt32(records.count))
+        writer.write(UInt32(index.data.count))
+        writer.write(CRC32.checksum(index.data))
+        writer.write(index.data)
+        for record in records {
+            writer.write(record.chunk.data)
+        }
+        return writer.data
+    }
+
+    /// Parses the header and index. Chunks are returned as slices of `data` and are not validated here;
+    /// callers check each chunk's checksum when they decode its payload.
+    public static func decode(_ data: Data) throws -> [DocumentBlockRecord] {
+        guard isContainer(data) else {
+            throw DocumentFormatError.notAContainer
+        }
+
+        do {
+            return try decodeRecords(data)
+        } catch BinaryCodingError.truncated {
+            throw DocumentFormatError.truncated
+        }
+    }
+
+    // MARK: - Private Helpers
+    private static func decodeRecords(_ data: Data) throws -> [DocumentBlockRecord] {
+        var reader = BinaryReader(data)
+        _ = try reader.readBytes(count: magic.count)
+        let version = try reader.read(UInt16.self)
+        guard version <= currentVersion else {
+            throw DocumentFormatError.unsupportedVersion(version)
+        }
+        _ = try reader.read(UInt16.self)
+        let blockCount = try reader.read(UInt32.self)
+        let indexLength = try reader.read(UInt32.self)
+        let indexChecksum = try reader.read(UInt32.self)
+
+        let indexData = try reader.readBytes(count: Int(indexLength))
+        guard CRC32.checksum(indexData) == indexChecksum else {
+            throw DocumentFormatError.corruptedIndex
+        }
+        let chunkArea = try reader.readBytes(count: reader.remaining)
+
+        var indexReader = BinaryReader(indexData)
+        var records: [DocumentBlockRecord] = []
+        // A crafted count must not drive the allocation; each record takes at least `minimumRecordSize` bytes.
+        records.reserveCapacity(min(Int(blockCount), indexData.count / minimumRecordSize))
+
+        for _ in 0..<blockCount {
+            let id = try indexReader.readUUID()
+            let typeCode = try indexReader.read(UInt8.self)
+            let flags = try indexReader.read(UInt8.self)
+            let textLength = try indexReader.read(UInt32.self)
+            let textData = try indexReader.readBytes(count: Int(textLength))
+            let offset = try indexReader.read(UInt64.self)
+            let length = try indexReader.read(UInt32.self)
+            let checksum = try indexReader.read(UInt32.self)
+
+            // Compared without adding, so a huge offset in a damaged index throws instead of overflowing.
+            guard offset <= UInt64(chunkArea.count), UInt64(length) <= UInt64(chunkArea.count) - offset else {
+                throw DocumentFormatError.truncated
+            }
+            let start = chunkArea.startIndex + Int(offset)
+            let chunkData = chunkArea[start..<start + Int(length)]
+
+            records.append(DocumentBlockRecord(
+                id: id,
+                typeCode: typeCode,
+                recognizedText: flags & Flag.hasRecognizedText != 0 ? String(decoding: textData, as: UTF8.self) : nil,
+                isModified: flags & Flag.isModified != 0,
+                chunk: DocumentChunk(data: chunkData, checksum: checksum)
+            ))
+        }
+
+        return records
+    }
+}
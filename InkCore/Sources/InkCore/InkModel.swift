@@ -0,0 +1,104 @@
+import Foundation
+
+/// Axis-aligned bounds in drawing coordinates. `null` contains nothing and is the identity of `union`.
+public struct InkRect: Equatable {
+    public static let null = InkRect(minX: .infinity, minY: .infinity, maxX: -.infinity, maxY: -.infinity)
+
+    public var minX: Float
+    public var minY: Float
+    public var maxX: Float
+    public var maxY: Float
+
+    public init(minX: Float, minY: Float, maxX: Float, maxY: Float) {
+        self.minX = minX
+        self.minY = minY
+        self.maxX = maxX
+        self.maxY = maxY
+    }
+
+    public var isNull: Bool {
+        minX > maxX || minY > maxY
+    }
+
+    public var width: Float {
+        isNull ? 0 : maxX - minX
+    }
+
+    public var height: Float {
+        isNull ? 0 : maxY - minY
+    }
+
+    public mutating func include(x: Float, y: Float) {
+        minX = min(minX, x)
+        minY = min(minY, y)
+        maxX = max(maxX, x)
+        maxY = max(maxY, y)
+    }
+
+    public func union(_ other: InkRect) -> InkRect {
+        InkRect(
+            minX: min(minX, other.minX),
+            minY: min(minY, other.minY),
+            maxX: max(maxX, other.maxX),
+            maxY: max(maxY, other.maxY)
+        )
+    }
+}
+
+public struct InkPoint: Equatable {
+    public var x: Float
+    public var y: Float
+    public var force: Float
+    /// Seconds since the start of the stroke.
+    public var timeOffset: Double
+
+    public init(x: Float, y: Float, force: Float, timeOffset: Double) {
+        self.x = x
+        self.y = y
+        self.force = force
+        self.timeOffset = timeOffset
+    }
+}
+
+public struct InkStroke: Equatable {
+    /// Seconds since the reference date; sample time offsets are relative to it.
+    public var creationTime: Double
+    public var samples: StrokeSampleBuffer
+
+    public init(creationTime: Double, samples: StrokeSampleBuffer) {
+        self.creationTime = creationTime
+        self.samples = samples
+    }
+
+    public var bounds: InkRect {
+        samples.bounds
+    }
+}
+
+public struct InkDrawing: Equatable {
+    public var strokes: [InkStroke]
+
+    public init(strokes: [InkStroke] = []) {
+        self.strokes = strokes
+    }
+
+    public var bounds: InkRect {
+        strokes.reduce(.null) { $0.union($1.bounds) }
+    }
+
+    public var pointCount: Int {
+        strokes.reduce(0) { $0 + $1.samples.count }
+    }
+
+    /// Geometry hash of the drawing, see `InkContentHasher`.
+    public var contentHash: UInt64 {
+        var hasher = InkContentHasher()
+        for stroke in strokes {
+            hasher.beginStroke(pointCount: stroke.samples.count)
+            for index in 0..<stroke.samples.count {
+                hasher.combinePoint(x: Double(stroke.samples.x[index]), y: Double(stroke.samples.y[index]))
+            }
+        }
+        return hasher.value
+    }
+}
@@ -0,0 +1,67 @@
+#if canImport(PencilKit)
+import PencilKit
+
+extension StrokeSampleBuffer {
+    /// Samples of `stroke` in drawing coordinates, written straight into the buffer's columns.
+    /// With an `interpolationDistance` the rendered curve is sampled instead of the control points.
+    public init(_ stroke: PKStroke, interpolationDistance: CGFloat? = nil) {
+        self.init(capacity: stroke.path.count)
+        if let interpolationDistance {
+            appendPoints(of: stroke.path.interpolatedPoints(in: nil, by: .distance(interpolationDistance)), transform: stroke.transform)
+        } else {
+            appendPoints(of: stroke.path, transform: stroke.transform)
+        }
+    }
+
+    private mutating func appendPoints(of points: some Sequence<PKStrokePoint>, transform: CGAffineTransform) {
+        for point in points {
+            let location = point.location.applying(transform)
+            append(x: Float(location.x), y: Float(location.y), force: Float(point.force), timeOffset: point.timeOffset)
+        }
+    }
+}
+
+extension InkStroke {
+    public init(_ stroke: PKStroke, interpolationDistance: CGFloat? = nil) {
+        self.init(
+            creationTime: stroke.path.creationDate.timeIntervalSinceReferenceDate,
+            samples: StrokeSampleBuffer(stroke, interpolationDistance: interpolationDistance)
+        )
+    }
+}
+
+extension InkDrawing {
+    public init(_ drawing: PKDrawing, interpolationDistance: CGFloat? = nil) {
+        self.init(strokes: drawing.strokes.map { InkStroke($0, interpolationDistance: interpolationDistance) })
+    }
+}
+
+extension PKStroke {
+    /// Builds the stroke path from the sample columns lazily, without an intermediate point array.
+    public init(_ stroke: InkStroke, ink: PKInk, pointSize: CGSize = CGSize(width: 3, height: 3)) {
+        let samples = stroke.samples
+        let points = (0..<samples.count).lazy.map { index in
+            PKStrokePoint(
+                location: CGPoint(x: CGFloat(samples.x[index]), y: CGFloat(samples.y[index])),
+                timeOffset: samples.timeOffset[index],
+                size: pointSize,
+                opacity: 1,
+                force: CGFloat(samples.force[index]),
+                azimuth: 0,
+                altitude: .pi / 2
+            )
+        }
+        let path = PKStrokePath(
+            controlPoints: points,
+            creationDate: Date(timeIntervalSinceReferenceDate: stroke.creationTime)
+        )
+        self.init(ink: ink, path: path)
+    }
+}
+
+extension PKDrawing {
+    public init(_ drawing: InkDrawing, ink: PKInk, pointSize: CGSize = CGSize(width: 3, height: 3)) {
+        self.init(strokes: drawing.strokes.map { PKStroke($0, ink: ink, pointSize: pointSize) })
+    }
+}
+#endif
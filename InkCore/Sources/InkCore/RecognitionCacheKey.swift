@@ -0,0 +1,33 @@
+import Foundation
+
+/// Identifies a recognition result: the same ink geometry recognized in the same mode, with the same
+/// language and assets, gives the same text.
+public struct RecognitionCacheKey: Hashable {
+    /// Hash of the drawing's ink geometry from `InkContentHasher`.
+    public let contentHash: UInt64
+    public let mode: String
+    public let language: String
+    public let assetVersion: String
+
+    public init(contentHash: UInt64, mode: String, language: String, assetVersion: String) {
+        self.contentHash = contentHash
+        self.mode = mode
+        self.language = language
+        self.assetVersion = assetVersion
+    }
+
+    /// Stable across launches and platforms, so results can be stored on disk under it.
+    public var fileName: String {
+        var hasher = FNV1aHasher()
+        hasher.combine(mode)
+        hasher.combine(language)
+        hasher.combine(assetVersion)
+        return "\(Self.hex(contentHash))-\(Self.hex(hasher.value))"
+    }
+
+    // MARK: - Private Helpers
+    private static func hex(_ value: UInt64) -> String {
+        let digits = String(value, radix: 16)
+        return String(repeating: "0", count: 16 - digits.count) + digits
+    }
+}
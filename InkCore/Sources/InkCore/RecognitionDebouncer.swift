@@ -0,0 +1,84 @@
+import Foundation
+
+/// Debounces recognition per block. Each block has its own timer, so a stroke in one block never delays
+/// or restarts another block's recognition.
+///
+/// The window follows the pace of writing in the block: about one and a half typical pauses between strokes,
+/// clamped to `minimumDelay...maximumDelay`. The first stroke after a pause fires after `minimumDelay`.
+/// The window itself is `DebounceWindow`, which replays change times without waiting on timers.
+@MainActor
+public final class RecognitionDebouncer {
+    public var onFire: ((UUID) -> Void)?
+
+    private var window: DebounceWindow
+    private var timers: [UUID: Task<Void, Never>] = [:]
+
+    public init(minimumDelay: TimeInterval = 0.1, maximumDelay: TimeInterval = 0.8) {
+        self.window = DebounceWindow(minimumDelay: minimumDelay, maximumDelay: maximumDelay)
+    }
+
+    public func blockDidChange(_ id: UUID) {
+        let delay = window.delay(afterChangeOf: id, at: ProcessInfo.processInfo.systemUptime)
+
+        timers[id]?.cancel()
+        timers[id] = Task { [weak self] in
+            try? await Task.sleep(nanoseconds: UInt64(delay * 1_000_000_000))
+            guard !Task.isCancelled else { return }
+            self?.fire(id)
+        }
+    }
+
+    public func cancel(_ id: UUID) {
+        timers.removeValue(forKey: id)?.cancel()
+        window.forget(id)
+    }
+
+    // MARK: - Private Helpers
+    private func fire(_ id: UUID) {
+        timers[id] = nil
+        onFire?(id)
+    }
+}
+
+/// Per-block debounce delays from the times the blocks changed.
+public struct DebounceWindow {
+    private struct BlockTiming {
+        var lastChange: TimeInterval
+        var averageInterval: TimeInterval?
+    }
+
+    public let minimumDelay: TimeInterval
+    public let maximumDelay: TimeInterval
+    private var timings: [UUID: BlockTiming] = [:]
+
+    public init(minimumDelay: TimeInterval, maximumDelay: TimeInterval) {
+        self.minimumDelay = minimumDelay
+        self.maximumDelay = maximumDelay
+    }
+
+    /// Records a change of the block at `now` and returns how long to wait for the next one.
+    public mutating func delay(afterChangeOf id: UUID, at now: TimeInterval) -> TimeInterval {
+        guard var timing = timings[id] else {
+            timings[id] = BlockTiming(lastChange: now)
+            return minimumDelay
+        }
+
+        let interval = now - timing.lastChange
+        timing.lastChange = now
+
+        guard interval < maximumDelay else {
+            timing.averageInterval = nil
+            timings[id] = timing
+            return minimumDelay
+        }
+
+        let average = timing.averageInterval.map { $0 * 0.7 + interval * 0.3 } ?? interval
+        timing.averageInterval = average
+        timings[id] = timing
+        return min(max(average * 1.5, minimumDelay), maximumDelay)
+    }
+
+    public mutating func forget(_ id: UUID) {
+        timings[id] = nil
+    }
+}
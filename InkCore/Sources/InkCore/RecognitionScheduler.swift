@@ -0,0 +1,193 @@
+import Foundation
+
+public enum RecognitionPriority: Int, Comparable {
+    case offscreen
+    case visible
+    case editing
+
+    public static func < (lhs: RecognitionPriority, rhs: RecognitionPriority) -> Bool {
+        lhs.rawValue < rhs.rawValue
+    }
+}
+
+/// What the scheduler needs to know about a job; the drawing and mode stay with the app's job type.
+public protocol SchedulableRecognitionJob {
+    var blockId: UUID { get }
+    /// Version of the block the job was built from, used to tell whether a result is still current.
+    var blockVersion: UInt64 { get }
+    /// Set by the scheduler when the job starts.
+    var priority: RecognitionPriority { get set }
+}
+
+/// Keeps at most one pending job per block and starts them by priority, then by submission order.
+///
+/// Pending jobs are block ids only: `makeJob` builds the job when it starts, so a block's strokes are not
+/// needed until a slot is free for it, and the job always carries the block's latest drawing.
+///
+/// When all slots are busy, a higher-priority job preempts the lowest-priority running one. The preempted
+/// job is cancelled and queued again, but it keeps its slot until its task returns: a job already inside the
+/// engine cannot be interrupted, and the worker pool only has as many workers as there are slots. A job still
+/// waiting for a worker returns at once. If the preempted job completes anyway, its result is delivered
+/// when it is still current. Only one preemption is in flight at a time.
+///
+/// Jobs run through `run`, so tests and replays can drive the scheduler with scripted recognitions.
+@MainActor
+public final class RecognitionScheduler<Job: SchedulableRecognitionJob> {
+    private struct PendingJob {
+        let blockId: UUID
+        var priority: RecognitionPriority
+        let order: Int
+    }
+
+    private struct RunningJob {
+        let job: Job
+        var priority: RecognitionPriority
+        let order: Int
+        let token: Int
+        let task: Task<Void, Never>
+    }
+
+    public var onResult: ((Job, Result<String, Error>) -> Void)?
+    /// Builds the job of a block about to start; `nil` drops it, for instance when its strokes cannot be loaded.
+    public var makeJob: ((UUID) -> Job?)?
+
+    private let run: (Job) async throws -> String
+    private let maxConcurrentJobs: Int
+    private var pendingJobs: [UUID: PendingJob] = [:]
+    private var runningJobs: [UUID: RunningJob] = [:]
+    /// Preempted jobs whose tasks have not returned yet, by token.
+    private var drainingJobs: [Int: Job] = [:]
+    private var nextOrder = 0
+    private var nextToken = 0
+
+    public var isIdle: Bool {
+        pendingJobs.isEmpty && runningJobs.isEmpty && drainingJobs.isEmpty
+    }
+
+    public init(maxConcurrentJobs: Int, run: @escaping (Job) async throws -> String) {
+        self.maxConcurrentJobs = max(1, maxConcurrentJobs)
+        self.run = run
+    }
+
+    /// Queues a job for the block, keeping the place of one that has not started yet.
+    public func schedule(blockId: UUID, priority: RecognitionPriority) {
+        let order = pendingJobs[blockId]?.order ?? makeOrder()
+        pendingJobs[blockId] = PendingJob(blockId: blockId, priority: priority, order: order)
+        dispatch()
+    }
+
+    public func updatePriorities(_ priority: (UUID) -> RecognitionPriority) {
+        for id in pendingJobs.keys {
+            pendingJobs[id]?.priority = priority(id)
+        }
+        for id in runningJobs.keys {
+            runningJobs[id]?.priority = priority(id)
+        }
+        dispatch()
+    }
+
+    /// Drops a block's job that has not started yet, leaving a running one to finish.
+    public func discardPending(blockId: UUID) {
+        pendingJobs[blockId] = nil
+    }
+
+    public func cancel(blockId: UUID) {
+        pendingJobs[blockId] = nil
+        runningJobs.removeValue(forKey: blockId)?.task.cancel()
+        dispatch()
+    }
+
+    // MARK: - Private Helpers
+    private func dispatch() {
+        while let next = nextPendingJob() {
+            if runningJobs.count + drainingJobs.count >= maxConcurrentJobs {
+                // The slot frees up when the preempted task returns, and `finish` dispatches again.
+                guard drainingJobs.isEmpty,
+                      let victim = runningJobs.values.min(by: { $0.priority < $1.priority }),
+                      victim.priority < next.priority else {
+                    return
+                }
+                preempt(victim)
+                return
+            }
+            start(next)
+        }
+    }
+
+    /// A block never has two jobs in flight, so its pending job waits for the running or preempted one.
+    private func nextPendingJob() -> PendingJob? {
+        let drainingBlockIds = Set(drainingJobs.values.map(\.blockId))
+        return pendingJobs.values
+            .filter { runningJobs[$0.blockId] == nil && !drainingBlockIds.contains($0.blockId) }
+            .min { lhs, rhs in
+                lhs.priority != rhs.priority ? lhs.priority > rhs.priority : lhs.order < rhs.order
+            }
+    }
+
+    private func preempt(_ running: RunningJob) {
+        let blockId = running.job.blockId
+        runningJobs[blockId] = nil
+        drainingJobs[running.token] = running.job
+        running.task.cancel()
+
+        if pendingJobs[blockId] == nil {
+            pendingJobs[blockId] = PendingJob(blockId: blockId, priority: running.priority, order: running.order)
+        }
+    }
+
+    private func start(_ pending: PendingJob) {
+        pendingJobs[pending.blockId] = nil
+        guard var job = makeJob?(pending.blockId) else { return }
+        job.priority = pending.priority
+        let token = nextToken
+        nextToken += 1
+
+        let task = Task { [weak self, run] in
+            let result: Result<String, Error>
+            do {
+                result = .success(try await run(job))
+            } catch {
+                result = .failure(error)
+            }
+            self?.finish(job, token: token, result: result)
+        }
+        runningJobs[job.blockId] = RunningJob(
+            job: job,
+            priority: pending.priority,
+            order: pending.order,
+            token: token,
+            task: task
+        )
+    }
+
+    private func finish(_ job: Job, token: Int, result: Result<String, Error>) {
+        if drainingJobs.removeValue(forKey: token) != nil {
+            finishPreempted(job, result: result)
+            dispatch()
+            return
+        }
+        // Cancelled jobs have already given up their slot.
+        guard runningJobs[job.blockId]?.token == token else { return }
+
+        runningJobs[job.blockId] = nil
+        onResult?(job, result)
+        dispatch()
+    }
+
+    /// A preempted job that ran to completion answers its own retry when the block has not changed since.
+    /// The block was running, so its strokes are loaded and building the retry's job is cheap.
+    private func finishPreempted(_ job: Job, result: Result<String, Error>) {
+        guard case .success = result,
+              pendingJobs[job.blockId] != nil,
+              makeJob?(job.blockId)?.blockVersion == job.blockVersion else {
+            return
+        }
+        pendingJobs[job.blockId] = nil
+        onResult?(job, result)
+    }
+
+    private func makeOrder() -> Int {
+        defer { nextOrder += 1 }
+        return nextOrder
+    }
+}
@@ -0,0 +1,171 @@
+import Foundation
+
+/// Recognized text of the document as one segment per block.
+///
+/// Updating a block splices only its segment: the segment is found through an id index and its offset in
+/// the joined text comes from a Fenwick tree of segment lengths, so an update costs O(log n). Each update
+/// records the UTF-16 range it replaced in `lastChange`, so consumers can redo only that part of their work.
+public struct RecognizedOutput: Equatable {
+    public struct Segment: Equatable {
+        public let blockId: UUID
+        /// `nil` leaves the block out of the joined text entirely, separators included.
+        public var text: String?
+
+        public init(blockId: UUID, text: String?) {
+            self.blockId = blockId
+            self.text = text
+        }
+    }
+
+    public struct Change: Equatable {
+        /// `nil` when the whole output was replaced.
+        public let blockId: UUID?
+        /// Replaced range in the UTF-16 view of the previous joined text.
+        public let replacedRange: Range<Int>
+        public let replacementLength: Int
+    }
+
+    /// Hands out revisions to an output and all of its copies, so copies that diverge never share a revision.
+    private final class Lineage {
+        private(set) var lastRevision = 0
+
+        func nextRevision() -> Int {
+            lastRevision += 1
+            return lastRevision
+        }
+    }
+
+    public static let separator = "\n\n"
+    private static let separatorLength = separator.utf16.count
+
+    public private(set) var segments: [Segment] = []
+    public private(set) var lastChange: Change?
+    /// Set on every change. Two outputs of the same lineage at the same revision hold the same segments,
+    /// so comparing them does not have to compare their text.
+    public private(set) var revision = 0
+
+    private var lineage = Lineage()
+
+    private var indexByBlockId: [UUID: Int] = [:]
+    /// Per segment: its UTF-16 length plus one separator, or zero when it is left out.
+    private var spans = FenwickTree(count: 0)
+
+    public init() { }
+
+    public init(segments: [Segment]) {
+        reset(segments)
+    }
+
+    public var utf16Count: Int {
+        max(spans.total - Self.separatorLength, 0)
+    }
+
+    /// Joins all segments; O(n), meant for consumers that need the whole text at once.
+    public var text: String {
+        segments.compactMap(\.text).joined(separator: Self.separator)
+    }
+
+    /// Whether both outputs are copies of one output, so that their revisions can be compared.
+    public func hasSameLineage(as other: RecognizedOutput) -> Bool {
+        lineage === other.lineage
+    }
+
+    public func segment(for blockId: UUID) -> Segment? {
+        indexByBlockId[blockId].map { segments[$0] }
+    }
+
+    public mutating func reset(_ newSegments: [Segment]) {
+        let previousLength = utf16Count
+
+        segments = newSegments
+        indexByBlockId = Dictionary(newSegments.enumerated().map { ($1.blockId, $0) }, uniquingKeysWith: { first, _ in first })
+        spans = FenwickTree(newSegments.map(Self.span(of:)))
+
+        lastChange = Change(blockId: nil, replacedRange: 0..<previousLength, replacementLength: utf16Count)
+        revision = lineage.nextRevision()
+    }
+
+    public mutating func setText(_ text: String?, for blockId: UUID) {
+        guard let index = indexByBlockId[blockId], segments[index].text != text else { return }
+
+        let oldSpan = Self.span(of: segments[index])
+        let newSegment = Segment(blockId: blockId, text: text)
+        let newSpan = Self.span(of: newSegment)
+        let start = spans.prefixSum(upTo: index)
+        let isLastIncluded = spans.total - start - oldSpan == 0
+
+        // The trailing separator belongs to the next segment's side when this one is last in the joined text.
+        var replacedStart = start
+        var replacedLength = oldSpan
+        var replacementLength = newSpan
+        if isLastIncluded {
+            if oldSpan > 0 { replacedLength -= Self.separatorLength }
+            if newSpan > 0 { replacementLength -= Self.separatorLength }
+            if (oldSpan == 0) != (newSpan == 0), start > 0 {
+                replacedStart -= Self.separatorLength
+                if oldSpan > 0 { replacedLength += Self.separatorLength } else { replacementLength += Self.separatorLength }
+            }
+        }
+
+        segments[index] = newSegment
+        spans.add(newSpan - oldSpan, at: index)
+
+        lastChange = Change(
+            blockId: blockId,
+            replacedRange: replacedStart..<replacedStart + replacedLength,
+            replacementLength: replacementLength
+        )
+        revision = lineage.nextRevision()
+    }
+
+    public static func == (lhs: RecognizedOutput, rhs: RecognizedOutput) -> Bool {
+        lhs.lineage === rhs.lineage && lhs.revision == rhs.revision
+    }
+
+    // MARK: - Private Helpers
+    private static func span(of segment: Segment) -> Int {
+        segment.text.map { $0.utf16.count + separatorLength } ?? 0
+    }
+}
+
+/// Prefix sums with O(log n) point updates.
+public struct FenwickTree {
+    private var tree: [Int]
+    public private(set) var total = 0
+
+    public init(count: Int) {
+        tree = Array(repeating: 0, count: count + 1)
+    }
+
+    /// Builds the tree in O(n).
+    public init(_ values: [Int]) {
+        tree = [0] + values
+        for index in 1..<max(tree.count, 1) {
+            let parent = index + (index & -index)
+            if parent < tree.count {
+                tree[parent] += tree[index]
+            }
+        }
+        total = values.reduce(0, +)
+    }
+
+    public mutating func add(_ delta: Int, at index: Int) {
+        total += delta
+        var position = index + 1
+        while position < tree.count {
+            tree[position] += delta
+            position += position & -position
+        }
+    }
+
+    /// Sum of the values before `index`.
+    public func prefixSum(upTo index: Int) -> Int {
+        var sum = 0
+        var position = index
+        while position > 0 {
+            sum += tree[position]
+            position -= position & -position
+        }
+        return sum
+    }
+}
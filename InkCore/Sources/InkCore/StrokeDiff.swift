@@ -0,0 +1,28 @@
+import Foundation
+
+/// Single contiguous edit turning one stroke list into another: strokes in `removed` of the old list
+/// are replaced by strokes in `inserted` of the new one. Appends, erases and replacements all map onto it.
+public struct StrokeDiff: Equatable {
+    public let removed: Range<Int>
+    public let inserted: Range<Int>
+
+    public var isEmpty: Bool {
+        removed.isEmpty && inserted.isEmpty
+    }
+
+    public init<Element: Equatable>(from old: [Element], to new: [Element]) {
+        var prefix = 0
+        while prefix < old.count, prefix < new.count, old[prefix] == new[prefix] {
+            prefix += 1
+        }
+
+        var suffix = 0
+        while suffix < old.count - prefix, suffix < new.count - prefix,
+              old[old.count - 1 - suffix] == new[new.count - 1 - suffix] {
+            suffix += 1
+        }
+
+        removed = prefix..<(old.count - suffix)
+        inserted = prefix..<(new.count - suffix)
+    }
+}
@@ -0,0 +1,135 @@
+import Foundation
+
+/// Struct-of-arrays samples of a single stroke, so per-coordinate passes run over contiguous buffers.
+public struct StrokeSampleBuffer: Equatable {
+    public private(set) var x: [Float] = []
+    public private(set) var y: [Float] = []
+    public private(set) var force: [Float] = []
+    public private(set) var timeOffset: [Double] = []
+    /// Kept up to date on append, so bounds never need a pass over the samples.
+    public private(set) var bounds = InkRect.null
+
+    public var count: Int {
+        x.count
+    }
+
+    public init(capacity: Int = 0) {
+        x.reserveCapacity(capacity)
+        y.reserveCapacity(capacity)
+        force.reserveCapacity(capacity)
+        timeOffset.reserveCapacity(capacity)
+    }
+
+    public subscript(index: Int) -> InkPoint {
+        InkPoint(x: x[index], y: y[index], force: force[index], timeOffset: timeOffset[index])
+    }
+
+    public mutating func append(x: Float, y: Float, force: Float, timeOffset: Double) {
+        self.x.append(x)
+        self.y.append(y)
+        self.force.append(force)
+        self.timeOffset.append(timeOffset)
+        bounds.include(x: x, y: y)
+    }
+
+    public mutating func append(_ point: InkPoint) {
+        append(x: point.x, y: point.y, force: point.force, timeOffset: point.timeOffset)
+    }
+
+    public func selecting(_ indices: [Int]) -> StrokeSampleBuffer {
+        var result = StrokeSampleBuffer(capacity: indices.count)
+        for index in indices {
+            result.append(x: x[index], y: y[index], force: force[index], timeOffset: timeOffset[index])
+        }
+        return result
+    }
+}
+
+public protocol StrokeResampler {
+    func resample(_ samples: StrokeSampleBuffer) -> StrokeSampleBuffer
+}
+
+public struct PassthroughResampler: StrokeResampler {
+    public init() {}
+
+    public func resample(_ samples: StrokeSampleBuffer) -> StrokeSampleBuffer {
+        samples
+    }
+}
+
+/// Curvature-aware decimation based on Ramer–Douglas–Peucker.
+///
+/// Every point gets the tolerance below which RDP would keep it. Points above `tolerance` are kept and,
+/// when that is still more than `maxPointsPerStroke`, only the most significant ones are. Endpoints are always kept.
+public struct DouglasPeuckerResampler: StrokeResampler {
+    public static let standard = DouglasPeuckerResampler()
+
+    public var tolerance: Float = 0.5
+    public var maxPointsPerStroke: Int = 256
+
+    public init(tolerance: Float = 0.5, maxPointsPerStroke: Int = 256) {
+        self.tolerance = tolerance
+        self.maxPointsPerStroke = maxPointsPerStroke
+    }
+
+    public func resample(_ samples: StrokeSampleBuffer) -> StrokeSampleBuffer {
+        guard samples.count > 2 else {
+            return samples
+        }
+
+        let importance = significance(of: samples)
+        var kept = importance.indices.filter { importance[$0] > tolerance }
+
+        if kept.count > maxPointsPerStroke {
+            kept = kept
+                .sorted { importance[$0] > importance[$1] }
+                .prefix(max(maxPointsPerStroke, 2))
+                .sorted()
+        }
+
+        return samples.selecting(kept)
+    }
+
+    private func significance(of samples: StrokeSampleBuffer) -> [Float] {
+        let count = samples.count
+        var importance = [Float](repeating: 0, count: count)
+        importance[0] = .infinity
+        importance[count - 1] = .infinity
+
+        var pending: [(first: Int, last: Int, bound: Float)] = [(0, count - 1, .infinity)]
+
+        samples.x.withUnsafeBufferPointer { x in
+            samples.y.withUnsafeBufferPointer { y in
+                while let span = pending.popLast() {
+                    let (first, last, bound) = span
+                    guard last - first > 1 else { continue }
+
+                    let start = SIMD2(x[first], y[first])
+                    let segment = SIMD2(x[last], y[last]) - start
+                    let length = (segment * segment).sum().squareRoot()
+
+                    var farthestIndex = first + 1
+                    var farthestDistance: Float = -1
+                    for index in (first + 1)..<last {
+                        let offset = SIMD2(x[index], y[index]) - start
+                        let distance = length > 0
+                            ? abs(segment.x * offset.y - segment.y * offset.x) / length
+                            : (offset * offset).sum().squareRoot()
+                        if distance > farthestDistance {
+                            farthestDistance = distance
+                            farthestIndex = index
+                        }
+                    }
+
+                    // A point can never be more significant than the split that exposed it.
+                    let splitSignificance = min(farthestDistance, bound)
+                    importance[farthestIndex] = splitSignificance
+                    pending.append((first, farthestIndex, splitSignificance))
+                    pending.append((farthestIndex, last, splitSignificance))
+                }
+            }
+        }
+
+        return importance
+    }
+}
@@ -0,0 +1,171 @@
+import Foundation
+import InkCore
+import InkFixtures
+
+// Run with `swift run -c release InkCoreBenchmarks [name-filter]`.
+// Inputs are generated from a fixed seed, so runs are comparable across machines and commits.
+
+/// One short line of text per block, as the recognizer returns for handwriting blocks.
+func makeOutput(blockCount: Int) -> RecognizedOutput {
+    RecognizedOutput(segments: (0..<blockCount).map { index in
+        RecognizedOutput.Segment(blockId: UUID(), text: "Recognized text of block \(index)")
+    })
+}
+
+/// Sample columns of every stroke, the size of the stroke payload a block of this drawing saves.
+func encodeSamples(_ drawing: InkDrawing) -> Data {
+    var writer = BinaryWriter(capacity: drawing.pointCount * 20)
+    for stroke in drawing.strokes {
+        writer.write(UInt32(stroke.samples.count))
+        for index in 0..<stroke.samples.count {
+            writer.write(stroke.samples.x[index].bitPattern)
+            writer.write(stroke.samples.y[index].bitPattern)
+            writer.write(stroke.samples.force[index].bitPattern)
+            writer.write(stroke.samples.timeOffset[index].bitPattern)
+        }
+    }
+    return writer.data
+}
+
+/// A few words of handwriting per block, most of them text, every fifth one math.
+func makeContainerRecords(blockCount: Int) -> (records: [DocumentBlockRecord], payloads: [Data]) {
+    let payloads = (0..<blockCount).map { index in
+        encodeSamples(SyntheticInk.drawing(strokeCount: 8, pointsPerStroke: 120, seed: UInt64(index)))
+    }
+    let records = payloads.enumerated().map { index, payload in
+        DocumentBlockRecord(
+            id: UUID(),
+            typeCode: index % 5 == 0 ? 1 : 0,
+            recognizedText: "Recognized text of block \(index)",
+            isModified: false,
+            chunk: DocumentChunk(data: payload)
+        )
+    }
+    return (records, payloads)
+}
+
+var editCount = 0
+
+/// Rewrites blocks spread over the whole output, one `setText` per edit.
+func edit(_ output: inout RecognizedOutput, times: Int) {
+    for _ in 0..<times {
+        editCount += 1
+        let segment = output.segments[(editCount &* 7_919) % output.segments.count]
+        output.setText("Edit \(editCount) of block", for: segment.blockId)
+    }
+    sink &+= UInt64(output.utf16Count)
+}
+
+struct Benchmark {
+    let name: String
+    let iterations: Int
+    let body: () -> Void
+}
+
+func run(_ benchmark: Benchmark) {
+    benchmark.body()
+
+    let clock = ContinuousClock()
+    var durations: [Duration] = []
+    durations.reserveCapacity(benchmark.iterations)
+    for _ in 0..<benchmark.iterations {
+        durations.append(clock.measure(benchmark.body))
+    }
+    durations.sort()
+
+    func microseconds(_ duration: Duration) -> Double {
+        let components = duration.components
+        return Double(components.seconds) * 1_000_000 + Double(components.attoseconds) / 1_000_000_000_000
+    }
+    let median = microseconds(durations[durations.count / 2])
+    let p90 = microseconds(durations[min(durations.count - 1, durations.count * 9 / 10)])
+    let line = benchmark.name.padding(toLength: 36, withPad: " ", startingAt: 0)
+    print("\(line) median \(String(format: "%10.1f", median)) µs   p90 \(String(format: "%10.1f", p90)) µs")
+}
+
+/// Keeps results observable so the optimizer cannot drop the measured work.
+var sink: UInt64 = 0
+
+let page = SyntheticInk.drawing(strokeCount: 400, pointsPerStroke: 120)
+let longStroke = SyntheticInk.drawing(strokeCount: 1, pointsPerStroke: 20_000).strokes[0]
+let fingerprints = page.strokes.map { $0.samples.count &* 31 &+ Int($0.creationTime) }
+let chunk = Data((0..<(1 << 20)).map { UInt8(truncatingIfNeeded: $0 &* 31) })
+var output1k = makeOutput(blockCount: 1_000)
+var output10k = makeOutput(blockCount: 10_000)
+let containerFixture = makeContainerRecords(blockCount: 1_000)
+var containerRecords = containerFixture.records
+let containerPayloads = containerFixture.payloads
+let savedContainer = DocumentContainer.encode(containerRecords)
+
+let benchmarks = [
+    Benchmark(name: "resample/douglas-peucker page", iterations: 50) {
+        let resampler = DouglasPeuckerResampler.standard
+        for stroke in page.strokes {
+            sink &+= UInt64(resampler.resample(stroke.samples).count)
+        }
+    },
+    Benchmark(name: "resample/douglas-peucker long stroke", iterations: 50) {
+        sink &+= UInt64(DouglasPeuckerResampler.standard.resample(longStroke.samples).count)
+    },
+    Benchmark(name: "hash/content page", iterations: 100) {
+        sink &+= page.contentHash
+    },
+    Benchmark(name: "diff/append one stroke", iterations: 1_000) {
+        let diff = StrokeDiff(from: Array(fingerprints.dropLast()), to: fingerprints)
+        sink &+= UInt64(diff.inserted.count)
+    },
+    // Per-edit cost should not grow with the block count; the join is what every edit cost before.
+    Benchmark(name: "output/100 edits, 1k blocks", iterations: 200) {
+        edit(&output1k, times: 100)
+    },
+    Benchmark(name: "output/100 edits, 10k blocks", iterations: 200) {
+        edit(&output10k, times: 100)
+    },
+    Benchmark(name: "output/full join, 1k blocks", iterations: 200) {
+        sink &+= UInt64(output1k.text.utf16.count)
+    },
+    // A full save builds every chunk; a save after one edit reuses the other chunks and their checksums, as the
+    // document does, and only copies their bytes into the file.
+    Benchmark(name: "container/save all, 1k blocks", iterations: 20) {
+        var records = containerRecords
+        for index in records.indices {
+            records[index].chunk = DocumentChunk(data: containerPayloads[index])
+        }
+        sink &+= UInt64(DocumentContainer.encode(records).count)
+    },
+    Benchmark(name: "container/save one changed chunk, 1k blocks", iterations: 20) {
+        editCount += 1
+        let index = (editCount &* 7_919) % containerRecords.count
+        containerRecords[index].chunk = DocumentChunk(data: containerPayloads[(index + 1) % containerPayloads.count])
+        sink &+= UInt64(DocumentContainer.encode(containerRecords).count)
+    },
+    // Only the index is read at load; chunks are validated when their block is faulted in.
+    Benchmark(name: "container/load, 1k blocks", iterations: 100) {
+        sink &+= UInt64(try! DocumentContainer.decode(savedContainer).count)
+    },
+    Benchmark(name: "bounds/page", iterations: 1_000) {
+        sink &+= UInt64(page.bounds.width)
+    },
+    Benchmark(name: "crc32/1 MiB", iterations: 50) {
+        sink &+= UInt64(CRC32.checksum(chunk))
+    },
+    Benchmark(name: "binary/write+read page samples", iterations: 50) {
+        var reader = BinaryReader(encodeSamples(page))
+        var readCount = 0
+        while reader.remaining > 0 {
+            let count = try! reader.read(UInt32.self)
+            for _ in 0..<count {
+                _ = try! reader.readBytes(count: 20)
+            }
+            readCount += Int(count)
+        }
+        precondition(readCount == page.pointCount, "Round trip lost samples")
+        sink &+= UInt64(readCount)
+    }
+]
+
+let filter = CommandLine.arguments.dropFirst().first
+for benchmark in benchmarks where filter.map({ benchmark.name.contains($0) }) ?? true {
+    run(benchmark)
+}
+print("checksum \(sink)")
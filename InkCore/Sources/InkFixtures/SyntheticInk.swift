@@ -0,0 +1,51 @@
+import Foundation
+import InkCore
+
+/// SplitMix64, so every benchmark and fixture draws the same sequence on every platform.
+public struct SeededGenerator: RandomNumberGenerator {
+    private var state: UInt64
+
+    public init(seed: UInt64) {
+        state = seed
+    }
+
+    public mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+        return z ^ (z >> 31)
+    }
+}
+
+/// Generated handwriting shared by the package benchmarks and the app benchmark target.
+/// PencilKit fixtures are built from these drawings through the adapters rather than generated separately.
+public enum SyntheticInk {
+    /// Handwriting-like strokes: short wobbly curves sampled every point or so, 120 Hz timestamps.
+    /// Strokes start on a grid of 40 columns, 14 points apart, with rows 30 points apart.
+    public static func drawing(strokeCount: Int, pointsPerStroke: Int, seed: UInt64 = 42) -> InkDrawing {
+        var generator = SeededGenerator(seed: seed)
+        var strokes: [InkStroke] = []
+        strokes.reserveCapacity(strokeCount)
+
+        for strokeIndex in 0..<strokeCount {
+            var samples = StrokeSampleBuffer(capacity: pointsPerStroke)
+            var x = Float(strokeIndex % 40) * 14
+            var y = Float(strokeIndex / 40) * 30
+            var heading = Float.random(in: 0..<(2 * .pi), using: &generator)
+            for pointIndex in 0..<pointsPerStroke {
+                heading += Float.random(in: -0.3...0.3, using: &generator)
+                x += cos(heading)
+                y += sin(heading)
+                samples.append(
+                    x: x,
+                    y: y,
+                    force: Float.random(in: 0.2...1, using: &generator),
+                    timeOffset: Double(pointIndex) / 120
+                )
+            }
+            strokes.append(InkStroke(creationTime: Double(strokeIndex), samples: samples))
+        }
+        return InkDrawing(strokes: strokes)
+    }
+}
@@ -0,0 +1,68 @@
+import XCTest
+import InkCore
+
+final class BinaryCodingTests: XCTestCase {
+    func testRoundTrip() throws {
+        let id = UUID()
+        var writer = BinaryWriter()
+        writer.write(UInt32(0xDEAD_BEEF))
+        writer.write(Int64(-42))
+        writer.write(id)
+        writer.write([1, 2, 3] as [UInt8])
+
+        var reader = BinaryReader(writer.data)
+
+        XCTAssertEqual(try reader.read(UInt32.self), 0xDEAD_BEEF)
+        XCTAssertEqual(try reader.read(Int64.self), -42)
+        XCTAssertEqual(try reader.readUUID(), id)
+        XCTAssertEqual(try reader.readBytes(count: 3), Data([1, 2, 3]))
+        XCTAssertEqual(reader.remaining, 0)
+    }
+
+    func testIntegersAreLittleEndian() {
+        var writer = BinaryWriter()
+        writer.write(UInt32(0x0102_0304))
+
+        XCTAssertEqual(writer.data, Data([4, 3, 2, 1]))
+    }
+
+    func testTruncatedIntegerThrows() {
+        var reader = BinaryReader(Data([1, 2, 3]))
+
+        XCTAssertThrowsError(try reader.read(UInt32.self)) { error in
+            XCTAssertEqual(error as? BinaryCodingError, .truncated)
+        }
+        XCTAssertEqual(reader.remaining, 3)
+    }
+
+    func testTruncatedUUIDThrows() {
+        var reader = BinaryReader(Data(count: 15))
+
+        XCTAssertThrowsError(try reader.readUUID()) { error in
+            XCTAssertEqual(error as? BinaryCodingError, .truncated)
+        }
+    }
+
+    func testReadingPastTheEndThrows() throws {
+        var reader = BinaryReader(Data([1, 2, 3, 4]))
+        _ = try reader.readBytes(count: 3)
+
+        XCTAssertThrowsError(try reader.readBytes(count: 2))
+        XCTAssertThrowsError(try reader.readBytes(count: -1))
+        XCTAssertEqual(try reader.readBytes(count: 1), Data([4]))
+    }
+
+    /// Readers over a slice start at the slice, not at index 0 of the underlying storage.
+    func testReaderOverSlice() throws {
+        let data = Data([9, 9, 1, 0, 0, 0])
+        var reader = BinaryReader(data[2...])
+
+        XCTAssertEqual(try reader.read(UInt32.self), 1)
+    }
+
+    func testCRC32Vectors() {
+        XCTAssertEqual(CRC32.checksum(Data()), 0)
+        XCTAssertEqual(CRC32.checksum(Data("123456789".utf8)), 0xCBF4_3926)
+        XCTAssertEqual(CRC32.checksum(Data("The quick brown fox jumps over the lazy dog".utf8)), 0x414F_A339)
+    }
+}
@@ -0,0 +1,51 @@
+import XCTest
+import InkCore
+
+/// The hashes name on-disk recognition cache entries, so their values must never change.
+final class ContentHashingTests: XCTestCase {
+    func testFNV1aVector() {
+        var hasher = FNV1aHasher()
+        hasher.combine(UInt8(ascii: "a"))
+
+        XCTAssertEqual(hasher.value, 0xAF63_DC4C_8601_EC8C)
+    }
+
+    func testContentHashIsStable() {
+        let drawing = makeDrawing([(0, 0, 0.5), (1.5, -2, 0.5)])
+
+        XCTAssertEqual(drawing.contentHash, 0x9218_86A4_9740_4AC0)
+    }
+
+    func testForceAndTimestampsDoNotChangeTheHash() {
+        var samples = StrokeSampleBuffer()
+        samples.append(x: 0, y: 0, force: 1, timeOffset: 3)
+        samples.append(x: 1.5, y: -2, force: 0.1, timeOffset: 4)
+        let other = InkDrawing(strokes: [InkStroke(creationTime: 100, samples: samples)])
+
+        XCTAssertEqual(other.contentHash, makeDrawing([(0, 0, 0.5), (1.5, -2, 0.5)]).contentHash)
+    }
+
+    func testSubQuantumMovesDoNotChangeTheHash() {
+        let drawing = makeDrawing([(0, 0, 1), (1.5, -2, 1)])
+        let jittered = makeDrawing([(0.01, -0.01, 1), (1.51, -2.01, 1)])
+
+        XCTAssertEqual(jittered.contentHash, drawing.contentHash)
+    }
+
+    func testStrokeBoundariesChangeTheHash() {
+        let single = makeDrawing([(0, 0, 1), (1, 1, 1)])
+        var split = makeDrawing([(0, 0, 1)])
+        split.strokes += makeDrawing([(1, 1, 1)]).strokes
+
+        XCTAssertNotEqual(split.contentHash, single.contentHash)
+    }
+
+    // MARK: - Private Helpers
+    private func makeDrawing(_ points: [(Float, Float, Float)]) -> InkDrawing {
+        var samples = StrokeSampleBuffer()
+        for (index, point) in points.enumerated() {
+            samples.append(x: point.0, y: point.1, force: point.2, timeOffset: Double(index))
+        }
+        return InkDrawing(strokes: [InkStroke(creationTime: 0, samples: samples)])
+    }
+}
@@ -0,0 +1,66 @@
+import XCTest
+import InkCore
+
+final class DocumentContainerTests: XCTestCase {
+    func testRoundTrip() throws {
+        let records = [
+            DocumentBlockRecord(id: UUID(), typeCode: 0, recognizedText: "x + 1", isModified: false, chunk: DocumentChunk(data: Data([1, 2, 3]))),
+            DocumentBlockRecord(id: UUID(), typeCode: 1, recognizedText: nil, isModified: true, chunk: DocumentChunk(data: Data())),
+            DocumentBlockRecord(id: UUID(), typeCode: 7, recognizedText: "", isModified: false, chunk: DocumentChunk(data: Data([9])))
+        ]
+
+        let data = DocumentContainer.encode(records)
+        let decoded = try DocumentContainer.decode(data)
+
+        XCTAssertTrue(DocumentContainer.isContainer(data))
+        XCTAssertEqual(decoded.map(\.id), records.map(\.id))
+        XCTAssertEqual(decoded.map(\.typeCode), [0, 1, 7])
+        XCTAssertEqual(decoded.map(\.recognizedText), ["x + 1", nil, ""])
+        XCTAssertEqual(decoded.map(\.isModified), [false, true, false])
+        for (record, original) in zip(decoded, records) {
+            XCTAssertEqual(try record.chunk.validated(blockId: record.id), original.chunk.data)
+        }
+    }
+
+    func testNotAContainerThrows() {
+        XCTAssertThrowsError(try DocumentContainer.decode(Data("{}".utf8))) { error in
+            XCTAssertEqual(error as? DocumentFormatError, .notAContainer)
+        }
+    }
+
+    func testCorruptedIndexThrows() {
+        var data = DocumentContainer.encode([
+            DocumentBlockRecord(id: UUID(), typeCode: 0, recognizedText: "a", isModified: false, chunk: DocumentChunk(data: Data([1])))
+        ])
+        // First byte of the index, right after the 20-byte header.
+        data[20] ^= 0xFF
+
+        XCTAssertThrowsError(try DocumentContainer.decode(data)) { error in
+            XCTAssertEqual(error as? DocumentFormatError, .corruptedIndex)
+        }
+    }
+
+    func testTruncatedChunkAreaThrows() {
+        let data = DocumentContainer.encode([
+            DocumentBlockRecord(id: UUID(), typeCode: 0, recognizedText: nil, isModified: false, chunk: DocumentChunk(data: Data(count: 64)))
+        ])
+
+        XCTAssertThrowsError(try DocumentContainer.decode(data.dropLast(1))) { error in
+            XCTAssertEqual(error as? DocumentFormatError, .truncated)
+        }
+    }
+
+    func testDamagedChunkFailsValidation() throws {
+        let id = UUID()
+        var data = DocumentContainer.encode([
+            DocumentBlockRecord(id: id, typeCode: 0, recognizedText: nil, isModified: false, chunk: DocumentChunk(data: Data([1, 2, 3])))
+        ])
+        data[data.count - 1] ^= 0xFF
+
+        let record = try XCTUnwrap(DocumentContainer.decode(data).first)
+
+        XCTAssertThrowsError(try record.chunk.validated(blockId: id)) { error in
+            XCTAssertEqual(error as? DocumentFormatError, .checksumMismatch(blockId: id))
+        }
+    }
+}
@@ -0,0 +1,37 @@
+import XCTest
+import InkCore
+
+/// File names address results stored by earlier launches, so their format must never change.
+final class RecognitionCacheKeyTests: XCTestCase {
+    func testFileNameIsStable() {
+        let key = RecognitionCacheKey(contentHash: 0xAB, mode: "text/plain", language: "en_US", assetVersion: "4.0.0")
+
+        XCTAssertEqual(key.fileName, "00000000000000ab-7027a6ac7b827bef")
+    }
+
+    func testRetimedInkHitsTheSameEntry() {
+        let drawing = InkDrawing(strokes: [stroke(timeOffset: 0)])
+        let redrawn = InkDrawing(strokes: [stroke(timeOffset: 5)])
+
+        XCTAssertEqual(key(for: redrawn, language: "en_US"), key(for: drawing, language: "en_US"))
+        XCTAssertEqual(key(for: redrawn, language: "en_US").fileName, key(for: drawing, language: "en_US").fileName)
+    }
+
+    func testLanguageSeparatesEntries() {
+        let drawing = InkDrawing(strokes: [stroke(timeOffset: 0)])
+
+        XCTAssertNotEqual(key(for: drawing, language: "en_US").fileName, key(for: drawing, language: "fr_FR").fileName)
+    }
+
+    // MARK: - Private Helpers
+    private func key(for drawing: InkDrawing, language: String) -> RecognitionCacheKey {
+        RecognitionCacheKey(contentHash: drawing.contentHash, mode: "text/plain", language: language, assetVersion: "4.0.0")
+    }
+
+    private func stroke(timeOffset: Double) -> InkStroke {
+        var samples = StrokeSampleBuffer()
+        samples.append(x: 0, y: 0, force: 1, timeOffset: timeOffset)
+        samples.append(x: 4, y: 2, force: 1, timeOffset: timeOffset + 0.1)
+        return InkStroke(creationTime: timeOffset, samples: samples)
+    }
+}
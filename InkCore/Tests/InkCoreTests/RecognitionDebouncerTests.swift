@@ -0,0 +1,70 @@
+import XCTest
+import InkCore
+
+final class RecognitionDebouncerTests: XCTestCase {
+    func testFirstChangeWaitsTheMinimum() {
+        var window = DebounceWindow(minimumDelay: 0.1, maximumDelay: 0.8)
+
+        XCTAssertEqual(window.delay(afterChangeOf: UUID(), at: 10), 0.1)
+    }
+
+    /// Strokes every 0.2 s settle on one and a half pauses.
+    func testSteadyWritingFollowsThePace() {
+        var window = DebounceWindow(minimumDelay: 0.1, maximumDelay: 0.8)
+        let id = UUID()
+
+        let delays = (0..<6).map { window.delay(afterChangeOf: id, at: Double($0) * 0.2) }
+
+        XCTAssertEqual(delays[0], 0.1)
+        for delay in delays.dropFirst() {
+            XCTAssertEqual(delay, 0.3, accuracy: 1e-9)
+        }
+    }
+
+    func testPauseResetsTheWindow() {
+        var window = DebounceWindow(minimumDelay: 0.1, maximumDelay: 0.8)
+        let id = UUID()
+        _ = window.delay(afterChangeOf: id, at: 0)
+        _ = window.delay(afterChangeOf: id, at: 0.4)
+
+        XCTAssertEqual(window.delay(afterChangeOf: id, at: 2), 0.1)
+        XCTAssertEqual(window.delay(afterChangeOf: id, at: 2.1), 0.15, accuracy: 1e-9)
+    }
+
+    func testDelayIsClamped() {
+        var window = DebounceWindow(minimumDelay: 0.1, maximumDelay: 0.8)
+        let id = UUID()
+        _ = window.delay(afterChangeOf: id, at: 0)
+
+        XCTAssertEqual(window.delay(afterChangeOf: id, at: 0.7), 0.8)
+        // The long pause still weighs on the average: (0.7 * 0.7 + 0.01 * 0.3) * 1.5.
+        XCTAssertEqual(window.delay(afterChangeOf: id, at: 0.71), 0.7395, accuracy: 1e-9)
+    }
+
+    func testBlocksAreIndependent() {
+        var window = DebounceWindow(minimumDelay: 0.1, maximumDelay: 0.8)
+        let first = UUID()
+        let second = UUID()
+        _ = window.delay(afterChangeOf: first, at: 0)
+        _ = window.delay(afterChangeOf: first, at: 0.4)
+
+        XCTAssertEqual(window.delay(afterChangeOf: second, at: 0.5), 0.1)
+        window.forget(first)
+        XCTAssertEqual(window.delay(afterChangeOf: first, at: 0.6), 0.1)
+    }
+
+    @MainActor
+    func testRapidChangesFireOnce() async throws {
+        let debouncer = RecognitionDebouncer(minimumDelay: 0.02, maximumDelay: 0.1)
+        let id = UUID()
+        var fired: [UUID] = []
+        debouncer.onFire = { fired.append($0) }
+
+        debouncer.blockDidChange(id)
+        debouncer.blockDidChange(id)
+        debouncer.blockDidChange(id)
+        try await Task.sleep(nanoseconds: 300_000_000)
+
+        XCTAssertEqual(fired, [id])
+    }
+}
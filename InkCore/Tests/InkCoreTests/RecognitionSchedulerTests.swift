@@ -0,0 +1,183 @@
+import XCTest
+import InkCore
+
+/// Replays scheduling scenarios against a recognizer whose jobs finish only when the test says so.
+@MainActor
+final class RecognitionSchedulerTests: XCTestCase {
+    private struct TestJob: SchedulableRecognitionJob {
+        let blockId: UUID
+        let blockVersion: UInt64
+        var priority: RecognitionPriority = .visible
+    }
+
+    @MainActor
+    private final class ScriptedRecognizer {
+        private(set) var started: [UUID] = []
+        private var continuations: [UUID: CheckedContinuation<String, Error>] = [:]
+
+        func run(_ job: TestJob) async throws -> String {
+            started.append(job.blockId)
+            return try await withCheckedThrowingContinuation { continuation in
+                continuations[job.blockId] = continuation
+            }
+        }
+
+        func isRunning(_ id: UUID) -> Bool {
+            continuations[id] != nil
+        }
+
+        func complete(_ id: UUID, with text: String) {
+            continuations.removeValue(forKey: id)?.resume(returning: text)
+        }
+    }
+
+    private var recognizer: ScriptedRecognizer!
+    private var versions: [UUID: UInt64] = [:]
+    private var builtJobs: [UUID] = []
+    private var results: [(blockId: UUID, text: String)] = []
+
+    private func makeScheduler(maxConcurrentJobs: Int) -> RecognitionScheduler<TestJob> {
+        recognizer = ScriptedRecognizer()
+        let recognizer = recognizer
+        let scheduler = RecognitionScheduler<TestJob>(maxConcurrentJobs: maxConcurrentJobs) { job in
+            try await recognizer.run(job)
+        }
+        scheduler.makeJob = { [unowned self] id in
+            builtJobs.append(id)
+            return versions[id].map { TestJob(blockId: id, blockVersion: $0) }
+        }
+        scheduler.onResult = { [unowned self] job, result in
+            if case .success(let text) = result {
+                results.append((job.blockId, text))
+            }
+        }
+        return scheduler
+    }
+
+    func testWaitingJobsStartByPriorityThenOrder() async {
+        let ids = (0..<3).map { _ in UUID() }
+        ids.forEach { versions[$0] = 1 }
+        let scheduler = makeScheduler(maxConcurrentJobs: 1)
+
+        scheduler.schedule(blockId: ids[0], priority: .visible)
+        scheduler.schedule(blockId: ids[1], priority: .offscreen)
+        scheduler.schedule(blockId: ids[2], priority: .visible)
+        await waitUntil { recognizer.isRunning(ids[0]) }
+
+        recognizer.complete(ids[0], with: "a")
+        await waitUntil { recognizer.isRunning(ids[2]) }
+        recognizer.complete(ids[2], with: "c")
+        await waitUntil { recognizer.isRunning(ids[1]) }
+        recognizer.complete(ids[1], with: "b")
+        await waitUntil { scheduler.isIdle }
+
+        XCTAssertEqual(recognizer.started, [ids[0], ids[2], ids[1]])
+        XCTAssertEqual(results.map(\.text), ["a", "c", "b"])
+    }
+
+    /// Rescheduling a waiting block keeps one job, built once with the version current when it starts.
+    func testPendingJobIsBuiltWhenItStarts() async {
+        let running = UUID()
+        let edited = UUID()
+        versions[running] = 1
+        versions[edited] = 1
+        let scheduler = makeScheduler(maxConcurrentJobs: 1)
+
+        scheduler.schedule(blockId: running, priority: .visible)
+        await waitUntil { recognizer.isRunning(running) }
+        for version in 2...4 {
+            versions[edited] = UInt64(version)
+            scheduler.schedule(blockId: edited, priority: .visible)
+        }
+
+        XCTAssertEqual(builtJobs, [running])
+
+        recognizer.complete(running, with: "r")
+        await waitUntil { recognizer.isRunning(edited) }
+        recognizer.complete(edited, with: "e")
+        await waitUntil { scheduler.isIdle }
+
+        XCTAssertEqual(builtJobs, [running, edited])
+        XCTAssertEqual(recognizer.started, [running, edited])
+    }
+
+    /// The preempted job keeps its slot until it returns; finished on an unchanged block, it answers its retry.
+    func testPreemptedJobThatFinishesAnswersItsRetry() async {
+        let background = UUID()
+        let editing = UUID()
+        versions[background] = 1
+        versions[editing] = 1
+        let scheduler = makeScheduler(maxConcurrentJobs: 1)
+
+        scheduler.schedule(blockId: background, priority: .offscreen)
+        await waitUntil { recognizer.isRunning(background) }
+        scheduler.schedule(blockId: editing, priority: .editing)
+        await settle()
+
+        XCTAssertEqual(recognizer.started, [background])
+
+        recognizer.complete(background, with: "background")
+        await waitUntil { recognizer.isRunning(editing) }
+        recognizer.complete(editing, with: "editing")
+        await waitUntil { scheduler.isIdle }
+
+        XCTAssertEqual(recognizer.started, [background, editing])
+        XCTAssertEqual(results.map(\.text), ["background", "editing"])
+    }
+
+    /// A block edited while its preempted job ran is recognized again instead of taking the stale text.
+    func testPreemptedJobOfChangedBlockRunsAgain() async {
+        let background = UUID()
+        let editing = UUID()
+        versions[background] = 1
+        versions[editing] = 1
+        let scheduler = makeScheduler(maxConcurrentJobs: 1)
+
+        scheduler.schedule(blockId: background, priority: .offscreen)
+        await waitUntil { recognizer.isRunning(background) }
+        scheduler.schedule(blockId: editing, priority: .editing)
+        versions[background] = 2
+        recognizer.complete(background, with: "stale")
+        await waitUntil { recognizer.isRunning(editing) }
+        recognizer.complete(editing, with: "editing")
+        await waitUntil { recognizer.isRunning(background) }
+        recognizer.complete(background, with: "current")
+        await waitUntil { scheduler.isIdle }
+
+        XCTAssertEqual(results.map(\.text), ["editing", "current"])
+    }
+
+    func testCancelledBlockDeliversNothing() async {
+        let id = UUID()
+        versions[id] = 1
+        let scheduler = makeScheduler(maxConcurrentJobs: 1)
+
+        scheduler.schedule(blockId: id, priority: .visible)
+        await waitUntil { recognizer.isRunning(id) }
+        scheduler.cancel(blockId: id)
+        recognizer.complete(id, with: "late")
+        await settle()
+
+        XCTAssertTrue(results.isEmpty)
+        XCTAssertTrue(scheduler.isIdle)
+    }
+
+    // MARK: - Private Helpers
+    /// Lets the scheduler's tasks run until `condition` holds, failing after a second.
+    private func waitUntil(_ condition: () -> Bool, file: StaticString = #filePath, line: UInt = #line) async {
+        let deadline = Date().addingTimeInterval(1)
+        while !condition() {
+            guard Date() < deadline else {
+                XCTFail("Condition not met", file: file, line: line)
+                return
+            }
+            await Task.yield()
+        }
+    }
+
+    private func settle() async {
+        for _ in 0..<50 {
+            await Task.yield()
+        }
+    }
+}
@@ -0,0 +1,84 @@
+import XCTest
+import InkCore
+
+final class RecognizedOutputTests: XCTestCase {
+    func testJoinedTextSkipsLeftOutSegments() {
+        let ids = (0..<3).map { _ in UUID() }
+        let output = RecognizedOutput(segments: [
+            .init(blockId: ids[0], text: "a"),
+            .init(blockId: ids[1], text: nil),
+            .init(blockId: ids[2], text: "c")
+        ])
+
+        XCTAssertEqual(output.text, "a\n\nc")
+        XCTAssertEqual(output.utf16Count, output.text.utf16.count)
+    }
+
+    /// Applying `lastChange` to the previous text must give the new text, whichever segment changes.
+    func testChangeRangeSplicesThePreviousText() throws {
+        let ids = (0..<4).map { _ in UUID() }
+        var output = RecognizedOutput(segments: ids.map { .init(blockId: $0, text: "x") })
+        let edits: [(Int, String?)] = [
+            (1, "hello"), (3, nil), (2, ""), (3, "tail"), (0, nil), (0, "héllo ∑"), (3, nil), (2, nil), (1, nil), (0, "only")
+        ]
+
+        for (index, text) in edits {
+            let previous = Array(output.text.utf16)
+            output.setText(text, for: ids[index])
+
+            let change = try XCTUnwrap(output.lastChange)
+            let current = Array(output.text.utf16)
+            let start = change.replacedRange.lowerBound
+            var spliced = previous
+            spliced.replaceSubrange(change.replacedRange, with: current[start..<start + change.replacementLength])
+            XCTAssertEqual(spliced, current, "edit of block \(index) to \(String(describing: text))")
+            XCTAssertEqual(output.utf16Count, output.text.utf16.count)
+        }
+    }
+
+    func testUnchangedTextKeepsTheRevision() {
+        let id = UUID()
+        var output = RecognizedOutput(segments: [.init(blockId: id, text: "a")])
+        let revision = output.revision
+
+        output.setText("a", for: id)
+        output.setText("b", for: UUID())
+
+        XCTAssertEqual(output.revision, revision)
+    }
+
+    func testDivergedCopiesAreNotEqual() {
+        let id = UUID()
+        let original = RecognizedOutput(segments: [.init(blockId: id, text: "a")])
+        var first = original
+        var second = original
+
+        XCTAssertEqual(first, second)
+
+        // Same length and the same block, so only the text tells them apart.
+        first.setText("bc", for: id)
+        second.setText("de", for: id)
+
+        XCTAssertNotEqual(first, second)
+        XCTAssertNotEqual(first, original)
+        XCTAssertEqual(first, first)
+    }
+
+    func testSeparatelyBuiltOutputsAreNotEqual() {
+        let id = UUID()
+        let first = RecognizedOutput(segments: [.init(blockId: id, text: "ab")])
+        let second = RecognizedOutput(segments: [.init(blockId: id, text: "cd")])
+
+        XCTAssertEqual(first.revision, second.revision)
+        XCTAssertFalse(first.hasSameLineage(as: second))
+        XCTAssertNotEqual(first, second)
+    }
+
+    func testFenwickPrefixSums() {
+        var tree = FenwickTree([3, 1, 4, 1, 5])
+        tree.add(2, at: 1)
+
+        XCTAssertEqual((0...5).map(tree.prefixSum(upTo:)), [0, 3, 6, 10, 11, 16])
+        XCTAssertEqual(tree.total, 16)
+    }
+}
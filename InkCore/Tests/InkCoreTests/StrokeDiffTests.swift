@@ -0,0 +1,45 @@
+import XCTest
+import InkCore
+
+final class StrokeDiffTests: XCTestCase {
+    func testEqualListsGiveAnEmptyDiff() {
+        let diff = StrokeDiff(from: [1, 2, 3], to: [1, 2, 3])
+
+        XCTAssertTrue(diff.isEmpty)
+        XCTAssertEqual(diff.removed, 3..<3)
+    }
+
+    func testAppend() {
+        let diff = StrokeDiff(from: [1, 2], to: [1, 2, 3, 4])
+
+        XCTAssertEqual(diff.removed, 2..<2)
+        XCTAssertEqual(diff.inserted, 2..<4)
+    }
+
+    func testEraseInTheMiddle() {
+        let diff = StrokeDiff(from: [1, 2, 3, 4], to: [1, 4])
+
+        XCTAssertEqual(diff.removed, 1..<3)
+        XCTAssertEqual(diff.inserted, 1..<1)
+    }
+
+    func testReplacement() {
+        let diff = StrokeDiff(from: [1, 2, 3], to: [1, 5, 6, 3])
+
+        XCTAssertEqual(diff.removed, 1..<2)
+        XCTAssertEqual(diff.inserted, 1..<3)
+    }
+
+    /// Prefix and suffix must not overlap when elements repeat.
+    func testRepeatedElements() {
+        let diff = StrokeDiff(from: [1, 1], to: [1, 1, 1])
+
+        XCTAssertEqual(diff.removed, 2..<2)
+        XCTAssertEqual(diff.inserted, 2..<3)
+    }
+
+    func testFromEmptyAndToEmpty() {
+        XCTAssertEqual(StrokeDiff(from: [], to: [7, 8]).inserted, 0..<2)
+        XCTAssertEqual(StrokeDiff(from: [7, 8], to: []).removed, 0..<2)
+    }
+}
@@ -0,0 +1,71 @@
+import XCTest
+import InkCore
+
+final class StrokeResamplingTests: XCTestCase {
+    func testStraightLineKeepsOnlyEndpoints() {
+        let samples = makeSamples((0..<50).map { (Float($0), Float($0) * 2) })
+
+        let resampled = DouglasPeuckerResampler(tolerance: 0.5).resample(samples)
+
+        XCTAssertEqual(resampled.count, 2)
+        XCTAssertEqual(resampled[0], samples[0])
+        XCTAssertEqual(resampled[1], samples[49])
+    }
+
+    func testCornerIsKept() {
+        let points = (0...10).map { (Float($0), Float(0)) } + (1...10).map { (Float(10), Float($0)) }
+        let samples = makeSamples(points)
+
+        let resampled = DouglasPeuckerResampler(tolerance: 0.5).resample(samples)
+
+        XCTAssertEqual(resampled.count, 3)
+        XCTAssertEqual(resampled[1].x, 10)
+        XCTAssertEqual(resampled[1].y, 0)
+    }
+
+    func testPointsWithinToleranceAreDropped() {
+        let samples = makeSamples((0..<20).map { (Float($0), $0 % 2 == 0 ? 0 : 0.1) })
+
+        let resampled = DouglasPeuckerResampler(tolerance: 0.5).resample(samples)
+
+        XCTAssertEqual(resampled.count, 2)
+    }
+
+    func testPointCountIsCapped() {
+        let samples = makeSamples((0..<1_000).map { (Float($0), $0 % 2 == 0 ? 0 : 10) })
+
+        let resampled = DouglasPeuckerResampler(tolerance: 0.5, maxPointsPerStroke: 64).resample(samples)
+
+        XCTAssertEqual(resampled.count, 64)
+        XCTAssertEqual(resampled[0], samples[0])
+        XCTAssertEqual(resampled[63], samples[999])
+        XCTAssertEqual(resampled.timeOffset, resampled.timeOffset.sorted())
+    }
+
+    func testShortStrokesAreUnchanged() {
+        let samples = makeSamples([(0, 0), (5, 5)])
+
+        XCTAssertEqual(DouglasPeuckerResampler.standard.resample(samples), samples)
+    }
+
+    func testPassthroughKeepsEverySample() {
+        let samples = makeSamples((0..<50).map { (Float($0), 0) })
+
+        XCTAssertEqual(PassthroughResampler().resample(samples), samples)
+    }
+
+    func testBoundsFollowAppendedSamples() {
+        let samples = makeSamples([(3, -1), (-2, 4), (1, 1)])
+
+        XCTAssertEqual(samples.bounds, InkRect(minX: -2, minY: -1, maxX: 3, maxY: 4))
+    }
+
+    // MARK: - Private Helpers
+    private func makeSamples(_ points: [(Float, Float)]) -> StrokeSampleBuffer {
+        var samples = StrokeSampleBuffer(capacity: points.count)
+        for (index, point) in points.enumerated() {
+            samples.append(x: point.0, y: point.1, force: 1, timeOffset: Double(index) / 120)
+        }
+        return samples
+    }
+}